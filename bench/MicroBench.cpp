@@ -0,0 +1,445 @@
+// QtSpaceShooterMicroBench: 热点函数微基准
+// 自带的小型计时框架 (不依赖 Google Benchmark)，按参数网格逐项测量：
+//   collision/check     CollisionSystem::check，子弹数 x 敌人数
+//   boss/update         BossStrategy::update，每个 bossId 的正常 / 狂暴状态
+//   bullets/integrate   SimdKernels::integrate，子弹数 x 指令集
+//   cleanup/bullets     BulletStore::removeInactive，失活比例
+//   cleanup/enemies     EnemyPool::removeInactive，失活比例
+// 每项重复若干轮，每轮至少跑 --min-time 毫秒，输出每次迭代耗时的中位数 / 最小 / 最大值 (JSON)。
+// 用法:
+//   QtSpaceShooterMicroBench [--filter 子串] [--min-time 毫秒] [--repetitions N] [--out 文件]
+
+#include "BossStrategy.h"
+#include "BulletStore.h"
+#include "CollisionSystem.h"
+#include "EnemyPool.h"
+#include "GameRandom.h"
+#include "Hitbox.h"
+#include "LevelManager.h"
+#include "SimdKernels.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace
+{
+    const double GAME_WIDTH = 1920.0 / 1080.0 * 600; // 1080p 窗口的逻辑宽度
+    const double GAME_HEIGHT = 600;
+
+    // ================= 计时框架 =================
+
+    // 一轮测量的状态：被测函数写成 while (state.keepRunning()) { ... }
+    // 需要在每次迭代前重建的数据放在 pauseTiming() / resumeTiming() 之间，不计入耗时
+    class BenchState
+    {
+    public:
+        explicit BenchState(qint64 minNs)
+            : m_minNs(minNs), m_iterations(0), m_timedNs(0), m_pausedAt(-1)
+        {
+        }
+
+        bool keepRunning()
+        {
+            if (m_iterations == 0)
+                m_clock.start();
+            else if (m_timedNs + m_clock.nsecsElapsed() >= m_minNs)
+            {
+                m_timedNs += m_clock.nsecsElapsed();
+                return false;
+            }
+            ++m_iterations;
+            return true;
+        }
+
+        void pauseTiming()
+        {
+            m_pausedAt = m_clock.nsecsElapsed();
+        }
+
+        void resumeTiming()
+        {
+            // 把暂停前的耗时攒起来，时钟从零重新计
+            m_timedNs += m_pausedAt;
+            m_clock.restart();
+        }
+
+        qint64 iterations() const { return m_iterations; }
+        double nsPerIteration() const { return m_iterations ? (double)m_timedNs / m_iterations : 0; }
+
+    private:
+        qint64 m_minNs;
+        qint64 m_iterations;
+        qint64 m_timedNs;
+        qint64 m_pausedAt;
+        QElapsedTimer m_clock;
+    };
+
+    struct BenchCase
+    {
+        QString name;
+        qint64 itemsPerIteration; // 每次迭代处理的元素数 (换算吞吐)，0 表示不统计
+        std::function<void(BenchState &)> run;
+    };
+
+    struct BenchResult
+    {
+        QString name;
+        qint64 iterations;
+        double medianNs, minNs, maxNs;
+        double itemsPerSec;
+    };
+
+    BenchResult measure(const BenchCase &bench, qint64 minNs, int repetitions)
+    {
+        // 预热一轮 (填缓存 / 分支预测)，不计入结果
+        {
+            BenchState warmup(minNs / 4);
+            bench.run(warmup);
+        }
+
+        std::vector<double> samples;
+        qint64 iterations = 0;
+        for (int r = 0; r < repetitions; ++r)
+        {
+            BenchState state(minNs);
+            bench.run(state);
+            samples.push_back(state.nsPerIteration());
+            iterations += state.iterations();
+        }
+        std::sort(samples.begin(), samples.end());
+
+        BenchResult result;
+        result.name = bench.name;
+        result.iterations = iterations;
+        result.medianNs = samples[samples.size() / 2];
+        result.minNs = samples.front();
+        result.maxNs = samples.back();
+        result.itemsPerSec = (bench.itemsPerIteration > 0 && result.medianNs > 0)
+                                 ? bench.itemsPerIteration * 1e9 / result.medianNs
+                                 : 0;
+        return result;
+    }
+
+    // ================= 场景构造 =================
+
+    Enemy makeEnemy(int type, double x, double y, int hp)
+    {
+        Enemy e = {};
+        e.type = type;
+        e.x = x;
+        e.y = y;
+        e.hp = hp;
+        e.maxHp = hp;
+        e.active = true;
+        e.state = STATE_NORMAL;
+        e.prevX = x;
+        e.prevY = y;
+        return e;
+    }
+
+    // 随机铺满画面的子弹 (一半敌方、一半玩家)
+    void fillBullets(BulletStore &bullets, int count, GameRandom &rng)
+    {
+        bullets.reserve(qMax(count, (int)BulletStore::DEFAULT_CAPACITY));
+        for (int i = 0; i < count; ++i)
+        {
+            const float x = rng.bounded((int)GAME_WIDTH);
+            const float y = rng.bounded((int)GAME_HEIGHT);
+            const float vx = (rng.bounded(21) - 10) / 2.0f;
+            const float vy = (rng.bounded(21) - 10) / 2.0f;
+            quint8 flags = (i & 1) ? BulletStore::FLAG_ENEMY : 0;
+            if (i % 7 == 0)
+                flags |= BulletStore::FLAG_SPECIAL;
+            bullets.add(x, y, vx, vy, flags);
+        }
+    }
+
+    // 把 from 原样拷到 to (to 已预留容量，不触发分配；add() 会置存活位，失活的要再杀一次)
+    void copyBullets(const BulletStore &from, BulletStore &to)
+    {
+        to.clear();
+        for (int i = 0; i < from.size(); ++i)
+        {
+            const int k = to.add(from.x[i], from.y[i], from.vx[i], from.vy[i], from.flags[i]);
+            if (!from.isActive(i))
+                to.kill(k);
+        }
+    }
+
+    void copyEnemies(const EnemyPool &from, EnemyPool &to)
+    {
+        to.clear();
+        for (const Enemy &e : from)
+            to.add(e);
+    }
+
+    // ================= 基准项 =================
+
+    void addCollisionCases(QList<BenchCase> &cases)
+    {
+        for (int bulletCount : {256, 2048, 16384})
+        {
+            for (int enemyCount : {8, 64, 256})
+            {
+                BenchCase bench;
+                bench.name = QString("collision/check/bullets:%1/enemies:%2").arg(bulletCount).arg(enemyCount);
+                bench.itemsPerIteration = bulletCount;
+                bench.run = [bulletCount, enemyCount](BenchState &state)
+                {
+                    GameRandom rng(bulletCount * 31 + enemyCount);
+                    BulletStore bulletTemplate, bullets;
+                    fillBullets(bulletTemplate, bulletCount, rng);
+                    bullets.reserve(bulletTemplate.capacity());
+
+                    // 血量足够高，迭代中不会有敌人死亡 (场景保持稳定)
+                    EnemyPool enemyTemplate(qMax(enemyCount, (int)EnemyPool::DEFAULT_CAPACITY));
+                    EnemyPool enemies(enemyTemplate.capacity());
+                    for (int i = 0; i < enemyCount; ++i)
+                        enemyTemplate.add(makeEnemy(i % 3, rng.bounded((int)GAME_WIDTH - 50),
+                                                    rng.bounded((int)GAME_HEIGHT - 200), 1 << 30));
+
+                    CollisionSystem::Broadphase broadphase;
+                    const HitboxTable hitboxes = HitboxTable::defaults();
+                    int progress = 0;
+                    while (state.keepRunning())
+                    {
+                        state.pauseTiming();
+                        copyBullets(bulletTemplate, bullets);
+                        copyEnemies(enemyTemplate, enemies);
+                        state.resumeTiming();
+
+                        CollisionSystem::check(broadphase, GAME_WIDTH, GAME_HEIGHT,
+                                               GAME_WIDTH / 2 - 30, GAME_HEIGHT - 100, 60, 60,
+                                               bullets, enemies, hitboxes,
+                                               false, false, PLANE_DEFAULT, 1, 1, 1000, progress);
+                    }
+                };
+                cases.append(bench);
+            }
+        }
+    }
+
+    void addBossCases(QList<BenchCase> &cases)
+    {
+        for (int bossId = 1; bossId <= 6; ++bossId)
+        {
+            for (bool enraged : {false, true})
+            {
+                BenchCase bench;
+                bench.name = QString("boss/update/boss:%1/%2").arg(bossId).arg(enraged ? "enraged" : "normal");
+                bench.itemsPerIteration = 0;
+                bench.run = [bossId, enraged](BenchState &state)
+                {
+                    const LevelConfig config = LevelManager::getLevelConfig(bossId);
+                    Enemy boss = makeEnemy(10, GAME_WIDTH / 2 - 100, 50, config.bossHp);
+                    boss.bossId = bossId;
+                    if (enraged)
+                        boss.hp = boss.maxHp / 2; // 低于 60% 进入狂暴
+
+                    BossStrategy strategy;
+                    BulletStore bullets;
+                    bullets.reserve(BulletStore::DEFAULT_CAPACITY);
+                    GameRandom rng(bossId);
+                    const double heroX = GAME_WIDTH / 2 - 30;
+                    const double heroY = GAME_HEIGHT - 100;
+                    while (state.keepRunning())
+                    {
+                        // 子弹池快满时清空 (O(1))，避免发射因池满被丢弃而失真
+                        if (bullets.size() > bullets.capacity() - 512)
+                            bullets.clear();
+                        strategy.update(boss, bullets, rng, heroX, heroY, (int)GAME_WIDTH, (int)GAME_HEIGHT, config);
+                    }
+                };
+                cases.append(bench);
+            }
+        }
+    }
+
+    bool isaSupported(SimdKernels::Isa isa)
+    {
+        const SimdKernels::Isa saved = SimdKernels::activeIsa();
+        SimdKernels::setIsa(isa);
+        const bool supported = SimdKernels::activeIsa() == isa;
+        SimdKernels::setIsa(saved);
+        return supported;
+    }
+
+    void addIntegrateCases(QList<BenchCase> &cases)
+    {
+        const SimdKernels::Isa isas[] = {SimdKernels::ISA_SCALAR, SimdKernels::ISA_SSE2, SimdKernels::ISA_AVX2};
+        for (int count : {1024, 8192, 65536})
+        {
+            for (SimdKernels::Isa isa : isas)
+            {
+                // setIsa 超出 CPU 能力时会静默降级，不支持的指令集直接跳过，避免结果挂错名字
+                if (!isaSupported(isa))
+                    continue;
+
+                BenchCase bench;
+                bench.name = QString("bullets/integrate/n:%1/isa:%2").arg(count).arg(SimdKernels::isaName(isa));
+                bench.itemsPerIteration = count;
+                bench.run = [count, isa](BenchState &state)
+                {
+                    GameRandom rng(count);
+                    BulletStore bullets;
+                    fillBullets(bullets, count, rng);
+
+                    const SimdKernels::Isa saved = SimdKernels::activeIsa();
+                    SimdKernels::setIsa(isa);
+                    // 边界放得足够大，子弹不会出界失活 (每次迭代工作量相同)
+                    while (state.keepRunning())
+                    {
+                        SimdKernels::integrate(bullets.x.data(), bullets.y.data(), bullets.vx.data(), bullets.vy.data(),
+                                               bullets.prevX.data(), bullets.prevY.data(), bullets.flags.data(),
+                                               bullets.size(), 0, -1e9f, -1e9f, 1e9f, 1e9f);
+                    }
+                    SimdKernels::setIsa(saved);
+                };
+                cases.append(bench);
+            }
+        }
+    }
+
+    void addCleanupCases(QList<BenchCase> &cases)
+    {
+        for (int deadPercent : {0, 10, 50, 90})
+        {
+            BenchCase bench;
+            bench.name = QString("cleanup/bullets/n:8192/dead:%1%").arg(deadPercent);
+            bench.itemsPerIteration = 8192;
+            bench.run = [deadPercent](BenchState &state)
+            {
+                GameRandom rng(deadPercent + 1);
+                BulletStore bulletTemplate, bullets;
+                fillBullets(bulletTemplate, 8192, rng);
+                for (int i = 0; i < bulletTemplate.size(); ++i)
+                    if (rng.bounded(100) < deadPercent)
+                        bulletTemplate.kill(i);
+                bullets.reserve(bulletTemplate.capacity());
+
+                while (state.keepRunning())
+                {
+                    state.pauseTiming();
+                    copyBullets(bulletTemplate, bullets);
+                    state.resumeTiming();
+                    bullets.removeInactive();
+                }
+            };
+            cases.append(bench);
+        }
+
+        for (int deadPercent : {0, 10, 50, 90})
+        {
+            BenchCase bench;
+            bench.name = QString("cleanup/enemies/n:256/dead:%1%").arg(deadPercent);
+            bench.itemsPerIteration = 256;
+            bench.run = [deadPercent](BenchState &state)
+            {
+                GameRandom rng(deadPercent + 1);
+                EnemyPool enemyTemplate, enemies;
+                for (int i = 0; i < EnemyPool::DEFAULT_CAPACITY; ++i)
+                {
+                    Enemy e = makeEnemy(i % 3, rng.bounded((int)GAME_WIDTH), rng.bounded((int)GAME_HEIGHT), 1);
+                    e.active = rng.bounded(100) >= deadPercent;
+                    enemyTemplate.add(e);
+                }
+
+                while (state.keepRunning())
+                {
+                    state.pauseTiming();
+                    copyEnemies(enemyTemplate, enemies);
+                    state.resumeTiming();
+                    enemies.removeInactive();
+                }
+            };
+            cases.append(bench);
+        }
+    }
+
+    void writeJson(QTextStream &out, const QList<BenchResult> &results, qint64 minNs, int repetitions)
+    {
+        out.setRealNumberNotation(QTextStream::FixedNotation);
+        out.setRealNumberPrecision(2);
+        out << "{\n  \"context\": {\"isa\": \"" << SimdKernels::isaName(SimdKernels::activeIsa())
+            << "\", \"min_time_ms\": " << (int)(minNs / 1000000)
+            << ", \"repetitions\": " << repetitions << "},\n"
+            << "  \"benchmarks\": [\n";
+        for (int i = 0; i < results.size(); ++i)
+        {
+            const BenchResult &r = results[i];
+            out << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+                << ", \"ns_per_iter\": " << r.medianNs
+                << ", \"ns_per_iter_min\": " << r.minNs << ", \"ns_per_iter_max\": " << r.maxNs
+                << ", \"items_per_sec\": " << r.itemsPerSec << "}"
+                << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QString filter, outPath;
+    qint64 minNs = 100 * 1000000LL;
+    int repetitions = 5;
+
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i)
+    {
+        const QString &a = args[i];
+        const bool hasValue = i + 1 < args.size();
+        if (a == "--filter" && hasValue)
+            filter = args[++i];
+        else if (a == "--min-time" && hasValue)
+            minNs = qMax(1, args[++i].toInt()) * 1000000LL;
+        else if (a == "--repetitions" && hasValue)
+            repetitions = qMax(1, args[++i].toInt());
+        else if (a == "--out" && hasValue)
+            outPath = args[++i];
+        else
+        {
+            QTextStream(stderr) << "usage: QtSpaceShooterMicroBench [--filter substr] [--min-time ms] "
+                                   "[--repetitions N] [--out file]\n";
+            return 2;
+        }
+    }
+
+    QList<BenchCase> cases;
+    addCollisionCases(cases);
+    addBossCases(cases);
+    addIntegrateCases(cases);
+    addCleanupCases(cases);
+
+    QList<BenchResult> results;
+    for (const BenchCase &bench : cases)
+    {
+        if (!filter.isEmpty() && !bench.name.contains(filter))
+            continue;
+        results.append(measure(bench, minNs, repetitions));
+        QTextStream(stderr) << bench.name << "\n"; // 进度
+    }
+
+    if (outPath.isEmpty())
+    {
+        QTextStream out(stdout);
+        writeJson(out, results, minNs, repetitions);
+    }
+    else
+    {
+        QFile file(outPath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            QTextStream(stderr) << "cannot write: " << outPath << "\n";
+            return 1;
+        }
+        QTextStream out(&file);
+        writeJson(out, results, minNs, repetitions);
+    }
+    return 0;
+}
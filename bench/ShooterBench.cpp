@@ -0,0 +1,332 @@
+// QtSpaceShooterBench: 无界面基准测试
+// 不创建任何 QWidget，直接驱动 GameSimulation，逐关卡 x 逐战机统计：
+//   每秒逻辑帧数、单帧耗时 p50 / p99 / 最大值、子弹与敌人峰值、每帧堆分配次数
+// 用法:
+//   QtSpaceShooterBench [--level N] [--plane N] [--ticks N] [--seed N] [--width W]
+//                       [--isa scalar|sse2|avx2] [--mortal] [--json] [--out 文件]
+//                       [--stress 倍率] [--spawn 刷怪间隔] [--capacity 子弹池容量] [--trace 文件]
+//   QtSpaceShooterBench --replay 录像文件 [--json] [--out 文件]
+// 默认英雄无敌 (否则后期关卡很快就结束)，输入为固定脚本：左右扫射 + 大招冷却好就放。
+// --stress N 让 BOSS 每次发射 N 倍子弹 (子弹池默认扩到 8192*N)，--spawn N 每 N 帧刷一只小怪，
+// 用来把同屏子弹推到 1 万 ~ 10 万量级，观察碰撞 / 移动内核的扩展性。
+
+#include "GameSimulation.h"
+#include "Replay.h"
+#include "LevelManager.h"
+#include "DataManager.h"
+#include "SimdKernels.h"
+#include "TraceRecorder.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QtMath>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// ================= 堆分配计数 =================
+// glibc 下直接接管 malloc 系列 (Qt 容器走 malloc，不经过 operator new)；
+// 其他平台只能统计 operator new。
+namespace
+{
+    std::atomic<quint64> g_allocCount(0);
+}
+
+#if defined(__GLIBC__)
+extern "C"
+{
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t count, size_t size);
+    void *__libc_realloc(void *ptr, size_t size);
+
+    void *malloc(size_t size)
+    {
+        g_allocCount.fetch_add(1, std::memory_order_relaxed);
+        return __libc_malloc(size);
+    }
+    void *calloc(size_t count, size_t size)
+    {
+        g_allocCount.fetch_add(1, std::memory_order_relaxed);
+        return __libc_calloc(count, size);
+    }
+    void *realloc(void *ptr, size_t size)
+    {
+        g_allocCount.fetch_add(1, std::memory_order_relaxed);
+        return __libc_realloc(ptr, size);
+    }
+}
+static const char *ALLOC_SOURCE = "malloc";
+#else
+void *operator new(std::size_t size)
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void *operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+static const char *ALLOC_SOURCE = "operator_new";
+#endif
+
+namespace
+{
+    const int GOD_MODE_HP = 1 << 30;
+    const double DEFAULT_WIDTH = 1920.0 / 1080.0 * GameSimulation::LOGICAL_HEIGHT; // 1080p 窗口的逻辑宽度
+
+    struct Options
+    {
+        int level = 0; // 0 = 全部关卡
+        int plane = -1; // -1 = 全部战机
+        int maxTicks = 20000;
+        quint64 seed = 20240601;
+        double width = DEFAULT_WIDTH;
+        bool mortal = false;
+        bool json = false;
+        StressConfig stress;
+        QString replayPath;
+        QString outPath;
+        QString tracePath; // 非空时记录逐帧阶段事件并导出 trace JSON (环形缓冲区只保留最近的事件)
+    };
+
+    struct RunResult
+    {
+        int level, plane;
+        int ticks;
+        bool finished, victory;
+        double ticksPerSec;
+        double p50Us, p99Us, maxUs;
+        int peakBullets, peakEnemies;
+        double allocsPerTick;
+    };
+
+    // 固定脚本输入：在画面下方左右扫射，大招冷却完毕立即释放
+    GameInput scriptedInput(const GameSimulation &sim, int tick)
+    {
+        const double w = sim.gameWidth();
+        GameInput input;
+        input.targetX = w / 2 + (w / 2 - 80) * qSin(tick * 0.013);
+        input.targetY = 470 + 50 * qSin(tick * 0.037);
+        input.ultPressed = sim.ultCooldownTimer() >= GameSimulation::ULT_COOLDOWN_MAX;
+        return input;
+    }
+
+    // 跑完一局 (或到达帧数上限)；replay 非空时输入取自录像
+    RunResult runOnce(GameSimulation &sim, const Replay *replay, int maxTicks)
+    {
+        RunResult r = {};
+        r.level = sim.levelConfig().levelId;
+        r.plane = sim.planeId();
+
+        std::vector<qint64> tickNs;
+        tickNs.reserve(maxTicks);
+        quint64 allocs = 0;
+
+        QElapsedTimer total, clock;
+        total.start();
+        for (int t = 0; t < maxTicks && !sim.isFinished(); ++t)
+        {
+            GameInput input = replay ? replay->applyTick(t, sim) : scriptedInput(sim, t);
+
+            const quint64 allocBefore = g_allocCount.load(std::memory_order_relaxed);
+            clock.start();
+            sim.tick(input);
+            const qint64 ns = clock.nsecsElapsed();
+            allocs += g_allocCount.load(std::memory_order_relaxed) - allocBefore;
+
+            tickNs.push_back(ns);
+            r.peakBullets = qMax(r.peakBullets, sim.bullets().size());
+            r.peakEnemies = qMax(r.peakEnemies, sim.enemies().size());
+        }
+        const qint64 totalNs = total.nsecsElapsed();
+
+        r.ticks = (int)tickNs.size();
+        r.finished = sim.isFinished();
+        r.victory = sim.isVictory();
+        if (r.ticks > 0)
+        {
+            r.ticksPerSec = r.ticks * 1e9 / qMax<qint64>(totalNs, 1);
+            r.allocsPerTick = (double)allocs / r.ticks;
+            std::sort(tickNs.begin(), tickNs.end());
+            r.p50Us = tickNs[r.ticks / 2] / 1000.0;
+            r.p99Us = tickNs[qMin(r.ticks - 1, r.ticks * 99 / 100)] / 1000.0;
+            r.maxUs = tickNs.back() / 1000.0;
+        }
+        return r;
+    }
+
+    bool parseArgs(const QStringList &args, Options &opt)
+    {
+        for (int i = 1; i < args.size(); ++i)
+        {
+            const QString &a = args[i];
+            const bool hasValue = i + 1 < args.size();
+            if (a == "--level" && hasValue)
+                opt.level = args[++i].toInt();
+            else if (a == "--plane" && hasValue)
+                opt.plane = args[++i].toInt();
+            else if (a == "--ticks" && hasValue)
+                opt.maxTicks = args[++i].toInt();
+            else if (a == "--seed" && hasValue)
+                opt.seed = args[++i].toULongLong();
+            else if (a == "--width" && hasValue)
+                opt.width = args[++i].toDouble();
+            else if (a == "--replay" && hasValue)
+                opt.replayPath = args[++i];
+            else if (a == "--out" && hasValue)
+                opt.outPath = args[++i];
+            else if (a == "--trace" && hasValue)
+                opt.tracePath = args[++i];
+            else if (a == "--stress" && hasValue)
+                opt.stress.emissionMultiplier = qBound(1, args[++i].toInt(), (int)StressConfig::MAX_EMISSION_MULTIPLIER);
+            else if (a == "--spawn" && hasValue)
+                opt.stress.spawnInterval = qBound(1, args[++i].toInt(), (int)StressConfig::MAX_SPAWN_INTERVAL);
+            else if (a == "--capacity" && hasValue)
+                opt.stress.bulletCapacity = qBound(0, args[++i].toInt(), (int)StressConfig::MAX_CAPACITY);
+            else if (a == "--isa" && hasValue)
+            {
+                const QString isa = args[++i];
+                SimdKernels::setIsa(isa == "scalar" ? SimdKernels::ISA_SCALAR
+                                    : isa == "sse2" ? SimdKernels::ISA_SSE2
+                                                    : SimdKernels::ISA_AVX2);
+            }
+            else if (a == "--mortal")
+                opt.mortal = true;
+            else if (a == "--json")
+                opt.json = true;
+            else
+                return false;
+        }
+        if (opt.stress.bulletCapacity <= 0)
+            opt.stress.bulletCapacity = BulletStore::DEFAULT_CAPACITY * opt.stress.emissionMultiplier;
+        if (opt.stress.spawnInterval > 0)
+            opt.stress.enemyCapacity = EnemyPool::DEFAULT_CAPACITY * 20 / opt.stress.spawnInterval;
+        return opt.maxTicks > 0;
+    }
+
+    void writeResults(QTextStream &out, const QList<RunResult> &results, const StressConfig &stress, bool json)
+    {
+        out.setRealNumberNotation(QTextStream::FixedNotation);
+        out.setRealNumberPrecision(2);
+
+        if (!json)
+        {
+            out << "level,plane,ticks,finished,victory,ticks_per_sec,p50_us,p99_us,max_us,"
+                   "peak_bullets,peak_enemies,allocs_per_tick\n";
+            for (const RunResult &r : results)
+            {
+                out << r.level << "," << r.plane << "," << r.ticks << ","
+                    << (r.finished ? 1 : 0) << "," << (r.victory ? 1 : 0) << ","
+                    << r.ticksPerSec << "," << r.p50Us << "," << r.p99Us << "," << r.maxUs << ","
+                    << r.peakBullets << "," << r.peakEnemies << "," << r.allocsPerTick << "\n";
+            }
+            return;
+        }
+
+        out << "{\n  \"isa\": \"" << SimdKernels::isaName(SimdKernels::activeIsa()) << "\",\n"
+            << "  \"stress\": " << stress.emissionMultiplier << ",\n"
+            << "  \"spawn_interval\": " << stress.spawnInterval << ",\n"
+            << "  \"alloc_source\": \"" << ALLOC_SOURCE << "\",\n"
+            << "  \"runs\": [\n";
+        for (int i = 0; i < results.size(); ++i)
+        {
+            const RunResult &r = results[i];
+            out << "    {\"level\": " << r.level << ", \"plane\": " << r.plane
+                << ", \"ticks\": " << r.ticks
+                << ", \"finished\": " << (r.finished ? "true" : "false")
+                << ", \"victory\": " << (r.victory ? "true" : "false")
+                << ", \"ticks_per_sec\": " << r.ticksPerSec
+                << ", \"p50_us\": " << r.p50Us << ", \"p99_us\": " << r.p99Us << ", \"max_us\": " << r.maxUs
+                << ", \"peak_bullets\": " << r.peakBullets << ", \"peak_enemies\": " << r.peakEnemies
+                << ", \"allocs_per_tick\": " << r.allocsPerTick << "}"
+                << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    Options opt;
+    if (!parseArgs(app.arguments(), opt))
+    {
+        QTextStream err(stderr);
+        err << "usage: QtSpaceShooterBench [--level N] [--plane N] [--ticks N] [--seed N] [--width W]\n"
+               "                           [--isa scalar|sse2|avx2] [--mortal] [--json] [--out file]\n"
+               "                           [--stress N] [--spawn N] [--capacity N] [--trace file]\n"
+               "       QtSpaceShooterBench --replay file [--json] [--out file]\n";
+        return 2;
+    }
+
+    if (!opt.tracePath.isEmpty())
+        TraceRecorder::setEnabled(true);
+
+    QList<RunResult> results;
+    if (!opt.replayPath.isEmpty())
+    {
+        Replay replay;
+        if (!replay.load(opt.replayPath))
+        {
+            QTextStream(stderr) << "cannot read replay: " << opt.replayPath << "\n";
+            return 1;
+        }
+        opt.stress = replay.stressConfig(); // 压力参数以录像为准
+        GameSimulation sim;
+        replay.startSimulation(sim);
+        results.append(runOnce(sim, &replay, replay.tickCount()));
+    }
+    else
+    {
+        for (int level = 1; level <= 6; ++level)
+        {
+            if (opt.level > 0 && level != opt.level)
+                continue;
+            for (int plane = 0; plane < 5; ++plane)
+            {
+                if (opt.plane >= 0 && plane != opt.plane)
+                    continue;
+
+                LoadoutSnapshot loadout = DataManager::buildLoadout(plane);
+                if (!opt.mortal)
+                    loadout.maxHp = GOD_MODE_HP;
+
+                GameSimulation sim;
+                // 与 GameWidget 相同的英雄尺寸 (泰坦 80，其余 60)
+                sim.setHeroSize(plane == PLANE_SHOTGUN ? QSize(80, 80) : QSize(60, 60));
+                sim.setGameWidth(opt.width);
+                sim.setStressConfig(opt.stress);
+                sim.start(LevelManager::getLevelConfig(level), loadout, opt.seed);
+                results.append(runOnce(sim, nullptr, opt.maxTicks));
+            }
+        }
+    }
+
+    if (!opt.tracePath.isEmpty() && !TraceRecorder::writeJson(opt.tracePath))
+        QTextStream(stderr) << "cannot write trace: " << opt.tracePath << "\n";
+
+    if (opt.outPath.isEmpty())
+    {
+        QTextStream out(stdout);
+        writeResults(out, results, opt.stress, opt.json);
+    }
+    else
+    {
+        QFile file(opt.outPath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            QTextStream(stderr) << "cannot write: " << opt.outPath << "\n";
+            return 1;
+        }
+        QTextStream out(&file);
+        writeResults(out, results, opt.stress, opt.json);
+    }
+    return 0;
+}
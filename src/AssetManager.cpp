@@ -0,0 +1,159 @@
+#include "AssetManager.h"
+#include "AssetPack.h"
+#include "common.h"
+#include "TraceRecorder.h"
+#include <QFileInfo>
+#include <QPromise>
+#include <QThreadPool>
+#include <memory>
+
+QHash<QString, QFuture<QImage>> AssetManager::m_assets;
+
+namespace
+{
+    const int PLANE_COUNT = 5;
+    const int LEVEL_COUNT = 6;
+}
+
+QList<AssetManager::ImageRequest> AssetManager::imageManifest()
+{
+    QList<ImageRequest> items;
+
+    // 游戏内精灵 (尺寸同 GameWidget 的显示尺寸)
+    for (int planeId = 0; planeId < PLANE_COUNT; ++planeId)
+    {
+        items.append({planePath(planeId), planeBox(planeId), true});
+        items.append({planePath(planeId), QSize(80, 80), true}); // 选机页按钮图标
+        items.append({"assets/hero.png", planeBox(planeId), true}); // 战机图缺失时的兜底
+    }
+    items.append({"assets/enemy.png", QSize(50, 50), true});
+    items.append({"assets/enemy2.png", QSize(50, 50), true});
+    items.append({"assets/enemy3.png", QSize(120, 120), true});
+
+    for (int i = 0; i < PLANE_COUNT; ++i)
+        items.append({QString("assets/bullet%1.png").arg(i), bulletBox(), true});
+
+    for (int level = 1; level <= LEVEL_COUNT; ++level)
+    {
+        const QString path = bossIconPath(level);
+        if (exists(path))
+            items.append({path, QSize(60, 60), true});
+    }
+
+    // 背景保留原图 (4K 原图展开后过大，按窗口尺寸另行缩放)
+    items.append({"assets/game_bg.png", QSize(), false});
+    return items;
+}
+
+QStringList AssetManager::soundManifest()
+{
+    QStringList sounds = {"assets/shoot.wav", "assets/explode.wav"};
+    for (int i = 0; i < PLANE_COUNT; ++i)
+        sounds.append(QString("assets/ult%1.wav").arg(i));
+    // 大招音效缺失时的兜底，可选 (目前没有随源码提供)
+    if (exists("assets/laser.wav"))
+        sounds.append("assets/laser.wav");
+    return sounds;
+}
+
+void AssetManager::preloadAll()
+{
+    TraceScope trace("asset", "preloadAll");
+    for (const ImageRequest &item : imageManifest())
+        request(item.path, item.box);
+}
+
+QString AssetManager::key(const QString &path, const QSize &box)
+{
+    if (box.isEmpty())
+        return path;
+    return QString("%1@%2x%3").arg(path).arg(box.width()).arg(box.height());
+}
+
+// 工作线程：解码 + 缩小 + 转成预乘格式 (贴图时不再转换)
+QImage AssetManager::decode(const QString &path, const QSize &box)
+{
+    const QByteArray detail = path.toUtf8();
+    TraceScope trace("asset", "decode image", detail.constData());
+
+    QImage image;
+    if (!image.load(path))
+        return QImage();
+    if (!box.isEmpty())
+        image = image.scaled(box, Qt::KeepAspectRatio);
+    return image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
+
+QFuture<QImage> AssetManager::request(const QString &path, const QSize &box)
+{
+    const QString k = key(path, box);
+    auto it = m_assets.constFind(k);
+    if (it != m_assets.constEnd())
+        return it.value();
+
+    std::shared_ptr<QPromise<QImage>> promise = std::make_shared<QPromise<QImage>>();
+    QFuture<QImage> future = promise->future();
+    promise->start();
+
+    // 资源包里有现成的缩放结果：直接引用映射内存，立即就绪
+    if (AssetPack::contains(k))
+    {
+        promise->addResult(AssetPack::image(k));
+        promise->finish();
+        m_assets.insert(k, future);
+        return future;
+    }
+
+    // QPromise 只能移动，放进共享指针以便交给线程池的可复制任务
+    QThreadPool::globalInstance()->start([promise, path, box]()
+                                         {
+                                             promise->addResult(decode(path, box));
+                                             promise->finish(); });
+    m_assets.insert(k, future);
+    return future;
+}
+
+QImage AssetManager::image(const QString &path, const QSize &box)
+{
+    QFuture<QImage> future = request(path, box);
+    if (!future.isFinished())
+    {
+        // 还没轮到的项由当前线程直接解码会与线程池重复，这里只等待
+        TraceScope trace("asset", "wait image");
+        future.waitForFinished();
+    }
+    return future.resultCount() > 0 ? future.result() : QImage();
+}
+
+bool AssetManager::isReady(const QString &path, const QSize &box)
+{
+    return request(path, box).isFinished();
+}
+
+bool AssetManager::exists(const QString &path)
+{
+    return AssetPack::containsSource(path) || QFileInfo::exists(path);
+}
+
+QString AssetManager::planePath(int planeId)
+{
+    if (planeId == 0)
+        return "assets/hero.png";
+    QString path = QString("assets/plane%1.png").arg(planeId);
+    if (!exists(path))
+        return "assets/hero.png";
+    return path;
+}
+
+QSize AssetManager::planeBox(int planeId)
+{
+    return planeId == PLANE_SHOTGUN ? QSize(80, 80) : QSize(60, 60);
+}
+
+QString AssetManager::bossIconPath(int level)
+{
+    QString path = QString("assets/boss%1.png").arg(level);
+    if (!exists(path))
+        path = QString("assets/boss%1.gif").arg(level);
+    return path;
+}
@@ -0,0 +1,66 @@
+#ifndef ASSETMANAGER_H
+#define ASSETMANAGER_H
+
+#include <QFuture>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+
+// 贴图资源管理
+// 大尺寸 PNG 的解码与缩小放到线程池里并行完成，每个 (路径, 尺寸) 只解码一次，全局共享同一份结果。
+// request() 立即返回 QFuture (已在解码或已完成)；image() 取结果，尚未完成时等待该项。
+// 启动时 preloadAll() 把游戏用到的贴图全部排进线程池，之后各页面 / 每局开始取图基本不再碰磁盘。
+// 构建时烘焙的资源包 (AssetPack) 已打开时，包里有的项直接取映射内存，不再解码。
+// 只在 GUI 线程调用。
+class AssetManager
+{
+public:
+    struct ImageRequest
+    {
+        QString path;
+        QSize box;
+        bool bake; // 是否烘焙进资源包 (超大原图如背景保持原文件)
+    };
+
+    // 游戏用到的全部贴图 / 音效 (预加载与烘焙工具共用这份清单)
+    static QList<ImageRequest> imageManifest();
+    static QStringList soundManifest();
+
+    // 启动预加载：战机 / 敌人 / 子弹 / 背景 / BOSS 头像
+    static void preloadAll();
+
+    // box 为空表示原图；否则按 KeepAspectRatio 缩放到 box 以内 (与原先 QImage::scaled 的默认取样一致)
+    static QFuture<QImage> request(const QString &path, const QSize &box = QSize());
+
+    // 取图 (阻塞到该项解码完成)，读取失败返回空图
+    static QImage image(const QString &path, const QSize &box = QSize());
+
+    static bool isReady(const QString &path, const QSize &box = QSize());
+
+    // 资源是否存在 (资源包里或 assets/ 目录下)
+    static bool exists(const QString &path);
+
+    // 战机贴图路径 (不存在时退回默认战机) 与游戏内尺寸
+    static QString planePath(int planeId);
+    static QSize planeBox(int planeId);
+
+    // BOSS 头像路径 (png 优先，其次 gif)
+    static QString bossIconPath(int level);
+
+    // 子弹贴图的源尺寸上限 (精灵按显示分辨率从它再缩放)
+    static QSize bulletBox() { return QSize(128, 128); }
+
+    // 资源键：原图为路径，缩放图为 "路径@宽x高" (资源包条目同名)
+    static QString key(const QString &path, const QSize &box);
+    // 从原文件解码 + 缩小 + 转预乘格式 (烘焙工具产出与运行时解码完全一致)
+    static QImage decode(const QString &path, const QSize &box);
+
+private:
+
+    static QHash<QString, QFuture<QImage>> m_assets;
+};
+
+#endif // ASSETMANAGER_H
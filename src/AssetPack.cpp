@@ -0,0 +1,239 @@
+#include "AssetPack.h"
+#include <QFile>
+#include <QHash>
+#include <QSet>
+#include <cstring>
+
+static_assert(sizeof(AssetPack::Header) == 16, "资源包头布局变化需要提升 VERSION");
+static_assert(sizeof(AssetPack::Entry) == 104, "资源包条目布局变化需要提升 VERSION");
+
+namespace
+{
+    QFile *g_file = nullptr;           // 映射期间必须保持打开
+    const uchar *g_base = nullptr;     // 映射起点
+    QHash<QString, const AssetPack::Entry *> g_entries;
+    QSet<QString> g_sources;
+
+    QString sourceOf(const QString &key)
+    {
+        const int at = key.indexOf('@');
+        return at < 0 ? key : key.left(at);
+    }
+
+    quint32 readU32(const QByteArray &data, int pos)
+    {
+        quint32 v;
+        memcpy(&v, data.constData() + pos, 4);
+        return v; // WAV 为小端，与目标平台一致
+    }
+
+    quint16 readU16(const QByteArray &data, int pos)
+    {
+        quint16 v;
+        memcpy(&v, data.constData() + pos, 2);
+        return v;
+    }
+}
+
+QString AssetPack::defaultPath()
+{
+    return "assets/assets.pack";
+}
+
+bool AssetPack::open(const QString &path)
+{
+    if (g_base)
+        return true;
+
+    QFile *file = new QFile(path);
+    if (!file->open(QIODevice::ReadOnly) || file->size() < (qint64)sizeof(Header))
+    {
+        delete file;
+        return false;
+    }
+    const uchar *base = file->map(0, file->size());
+    if (!base)
+    {
+        delete file;
+        return false;
+    }
+
+    // 校验头与条目表，任何越界都视为坏包，整包不用
+    const Header *header = reinterpret_cast<const Header *>(base);
+    const quint64 fileSize = (quint64)file->size();
+    const quint64 tableEnd = sizeof(Header) + (quint64)header->entryCount * sizeof(Entry);
+    if (header->magic != MAGIC || header->version != VERSION || tableEnd > fileSize)
+    {
+        delete file;
+        return false;
+    }
+    const Entry *entries = reinterpret_cast<const Entry *>(base + sizeof(Header));
+    QHash<QString, const Entry *> index;
+    for (quint32 i = 0; i < header->entryCount; ++i)
+    {
+        const Entry &e = entries[i];
+        if (e.offset < tableEnd || e.offset + e.size > fileSize || e.name[NAME_LEN - 1] != 0)
+        {
+            delete file;
+            return false;
+        }
+        index.insert(QString::fromUtf8(e.name), &e);
+    }
+
+    g_file = file;
+    g_base = base;
+    g_entries = index;
+    for (auto it = g_entries.constBegin(); it != g_entries.constEnd(); ++it)
+        g_sources.insert(sourceOf(it.key()));
+    return true;
+}
+
+bool AssetPack::isOpen()
+{
+    return g_base != nullptr;
+}
+
+const AssetPack::Entry *AssetPack::find(const QString &key)
+{
+    return g_entries.value(key, nullptr);
+}
+
+bool AssetPack::contains(const QString &key)
+{
+    return find(key) != nullptr;
+}
+
+bool AssetPack::containsSource(const QString &path)
+{
+    return g_sources.contains(path);
+}
+
+QImage AssetPack::image(const QString &key)
+{
+    const Entry *e = find(key);
+    if (!e || e->type != ENTRY_IMAGE)
+        return QImage();
+    const int width = e->params[0];
+    const int height = e->params[1];
+    const int bytesPerLine = e->params[2];
+    if ((quint64)bytesPerLine * height > e->size)
+        return QImage();
+    // const uchar* 构造：直接引用映射内存，只读，写入时才会分离拷贝
+    return QImage(g_base + e->offset, width, height, bytesPerLine, QImage::Format_ARGB32_Premultiplied);
+}
+
+AssetPack::Sound AssetPack::sound(const QString &key)
+{
+    Sound s;
+    const Entry *e = find(key);
+    if (!e || e->type != ENTRY_PCM)
+        return s;
+    s.data = reinterpret_cast<const char *>(g_base + e->offset);
+    s.size = (int)e->size;
+    s.sampleRate = e->params[0];
+    s.channels = e->params[1];
+    s.bitsPerSample = e->params[2];
+    return s;
+}
+
+bool AssetPack::decodeWav(const QByteArray &file, Sound &format, QByteArray &pcm)
+{
+    if (file.size() < 12 || !file.startsWith("RIFF") || file.mid(8, 4) != "WAVE")
+        return false;
+
+    bool haveFormat = false;
+    int pos = 12;
+    while (pos + 8 <= file.size())
+    {
+        const QByteArray id = file.mid(pos, 4);
+        const quint32 size = readU32(file, pos + 4);
+        const int body = pos + 8;
+        if ((quint64)body + size > (quint64)file.size())
+            return false;
+
+        if (id == "fmt " && size >= 16)
+        {
+            if (readU16(file, body) != 1) // 只支持整数 PCM
+                return false;
+            format.channels = readU16(file, body + 2);
+            format.sampleRate = (int)readU32(file, body + 4);
+            format.bitsPerSample = readU16(file, body + 14);
+            haveFormat = true;
+        }
+        else if (id == "data" && haveFormat)
+        {
+            pcm = file.mid(body, (int)size);
+            format.data = pcm.constData();
+            format.size = pcm.size();
+            return true;
+        }
+        pos = body + (int)size + (size & 1); // 块按偶数字节对齐
+    }
+    return false;
+}
+
+// ================= 写出 (烘焙工具) =================
+void AssetPack::Writer::addImage(const QString &key, const QImage &image)
+{
+    const QImage premultiplied = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    Item item;
+    memset(&item.entry, 0, sizeof(Entry));
+    strncpy(item.entry.name, key.toUtf8().constData(), NAME_LEN - 1);
+    item.entry.type = ENTRY_IMAGE;
+    item.entry.params[0] = premultiplied.width();
+    item.entry.params[1] = premultiplied.height();
+    item.entry.params[2] = (qint32)premultiplied.bytesPerLine();
+    item.data = QByteArray(reinterpret_cast<const char *>(premultiplied.constBits()), (int)premultiplied.sizeInBytes());
+    m_items.append(item);
+}
+
+void AssetPack::Writer::addSound(const QString &key, const Sound &format, const QByteArray &pcm)
+{
+    Item item;
+    memset(&item.entry, 0, sizeof(Entry));
+    strncpy(item.entry.name, key.toUtf8().constData(), NAME_LEN - 1);
+    item.entry.type = ENTRY_PCM;
+    item.entry.params[0] = format.sampleRate;
+    item.entry.params[1] = format.channels;
+    item.entry.params[2] = format.bitsPerSample;
+    item.data = pcm;
+    m_items.append(item);
+}
+
+bool AssetPack::Writer::write(const QString &path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    Header header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.entryCount = (quint32)m_items.size();
+    header.reserved = 0;
+
+    // 先排好数据区偏移，再依次写 头 / 条目表 / 数据
+    QList<Entry> entries;
+    quint64 offset = sizeof(Header) + (quint64)m_items.size() * sizeof(Entry);
+    for (const Item &item : m_items)
+    {
+        offset = (offset + DATA_ALIGN - 1) / DATA_ALIGN * DATA_ALIGN;
+        Entry e = item.entry;
+        e.offset = offset;
+        e.size = (quint64)item.data.size();
+        entries.append(e);
+        offset += e.size;
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    for (const Entry &e : entries)
+        file.write(reinterpret_cast<const char *>(&e), sizeof(Entry));
+    for (int i = 0; i < m_items.size(); ++i)
+    {
+        const qint64 padding = (qint64)entries[i].offset - file.pos();
+        if (padding > 0)
+            file.write(QByteArray((int)padding, '\0'));
+        file.write(m_items[i].data);
+    }
+    return file.error() == QFileDevice::NoError;
+}
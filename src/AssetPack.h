@@ -0,0 +1,97 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QList>
+#include <QString>
+
+// 资源包 (assets/assets.pack)
+// 构建时由 QtSpaceShooterAssetBaker 生成：贴图已缩放到游戏内尺寸并转成预乘 ARGB32，音效已解出 PCM。
+// 运行时整包内存映射，image() 直接用映射内存构造 QImage (不拷贝、不解码)。
+// 文件布局 (本机字节序，与游戏同机构建)：
+//   Header | Entry x entryCount | 数据区 (每项按 DATA_ALIGN 对齐)
+// 没有资源包时各接口返回空，调用方退回从 assets/ 目录读原文件。
+class AssetPack
+{
+public:
+    static const quint32 MAGIC = 0x4B505353; // "SSPK"
+    static const quint32 VERSION = 1;
+    static const int NAME_LEN = 64;
+    static const int DATA_ALIGN = 16;
+
+    enum EntryType
+    {
+        ENTRY_IMAGE = 1,
+        ENTRY_PCM = 2
+    };
+
+    struct Header
+    {
+        quint32 magic;
+        quint32 version;
+        quint32 entryCount;
+        quint32 reserved;
+    };
+
+    struct Entry
+    {
+        char name[NAME_LEN]; // 资源键 (见 AssetManager::key)，以 0 结尾
+        quint32 type;
+        quint32 reserved;
+        quint64 offset; // 相对文件头
+        quint64 size;
+        qint32 params[4]; // 贴图：宽 / 高 / 每行字节数；PCM：采样率 / 声道数 / 位深
+    };
+
+    // 一段 PCM 数据 (指向映射内存或调用方持有的缓冲)
+    struct Sound
+    {
+        const char *data = nullptr;
+        int size = 0;
+        int sampleRate = 0;
+        int channels = 0;
+        int bitsPerSample = 0;
+        bool isNull() const { return data == nullptr || size <= 0; }
+    };
+
+    static QString defaultPath();
+
+    // 内存映射打开资源包 (映射一直保留到进程结束)
+    static bool open(const QString &path);
+    static bool isOpen();
+
+    static bool contains(const QString &key);
+    // 包里是否有来自该源文件的任何一项 (源文件本身可能没有随程序分发)
+    static bool containsSource(const QString &path);
+
+    // 映射内存上的只读 QImage；不存在时返回空图
+    static QImage image(const QString &key);
+    static Sound sound(const QString &key);
+
+    // 解析 PCM WAV 文件：format 取格式信息，pcm 取数据块 (format.data 指向 pcm)
+    static bool decodeWav(const QByteArray &file, Sound &format, QByteArray &pcm);
+
+    // 烘焙工具用：收集条目后一次写出
+    class Writer
+    {
+    public:
+        void addImage(const QString &key, const QImage &image);
+        void addSound(const QString &key, const Sound &format, const QByteArray &pcm);
+        bool write(const QString &path) const;
+        int count() const { return m_items.size(); }
+
+    private:
+        struct Item
+        {
+            Entry entry;
+            QByteArray data;
+        };
+        QList<Item> m_items;
+    };
+
+private:
+    static const Entry *find(const QString &key);
+};
+
+#endif // ASSETPACK_H
@@ -0,0 +1,313 @@
+#include "AudioMixer.h"
+#include "AssetPack.h"
+#include "TraceRecorder.h"
+#include <QAudioSink>
+#include <QDebug>
+#include <QFile>
+#include <QMediaDevices>
+#include <QThread>
+#include <cstring>
+
+// 拉模式数据源：QAudioSink 要多少给多少，没有声音时给静音
+class AudioMixer::MixerDevice : public QIODevice
+{
+public:
+    explicit MixerDevice(AudioMixer *mixer) : m_mixer(mixer) {}
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override { return 4096 + QIODevice::bytesAvailable(); }
+
+protected:
+    qint64 readData(char *data, qint64 maxlen) override
+    {
+        const int frameBytes = m_mixer->m_format.bytesPerFrame();
+        if (frameBytes <= 0)
+            return 0;
+        // mix() 一次最多混 1 秒，返回实际写入的帧数；不足的部分 sink 会再来取
+        const qint64 wanted = qMin(maxlen / frameBytes, (qint64)m_mixer->m_accumulator.size() / 2);
+        const int frames = m_mixer->mix(data, (int)wanted);
+        return (qint64)frames * frameBytes;
+    }
+
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    AudioMixer *m_mixer;
+};
+
+namespace
+{
+    // 任意 8 / 16 位、单 / 双声道、任意采样率的 PCM -> 目标采样率的 16 位立体声 (线性插值)
+    QVector<qint16> convert(const AssetPack::Sound &in, int outRate)
+    {
+        QVector<qint16> out;
+        if (in.isNull() || in.channels < 1 || in.sampleRate <= 0 || (in.bitsPerSample != 8 && in.bitsPerSample != 16))
+            return out;
+
+        const int bytesPerSample = in.bitsPerSample / 8;
+        const int inFrames = in.size / (bytesPerSample * in.channels);
+        auto sampleAt = [&](int frame, int channel) -> int
+        {
+            const int c = qMin(channel, in.channels - 1); // 单声道两边相同
+            const char *p = in.data + (frame * in.channels + c) * bytesPerSample;
+            if (bytesPerSample == 1)
+                return ((int)(quint8)*p - 128) << 8; // 8 位 WAV 为无符号
+            qint16 v;
+            memcpy(&v, p, 2);
+            return v;
+        };
+
+        const double step = (double)in.sampleRate / outRate;
+        const int outFrames = (int)(inFrames / step);
+        out.resize(outFrames * 2);
+        for (int i = 0; i < outFrames; ++i)
+        {
+            const double src = i * step;
+            const int f0 = (int)src;
+            const int f1 = qMin(f0 + 1, inFrames - 1);
+            const double t = src - f0;
+            for (int ch = 0; ch < 2; ++ch)
+                out[i * 2 + ch] = (qint16)(sampleAt(f0, ch) * (1.0 - t) + sampleAt(f1, ch) * t);
+        }
+        return out;
+    }
+}
+
+AudioMixer::AudioMixer(QObject *parent)
+    : QObject(parent)
+{
+    // 设备只在这里 (GUI 线程) 选一次，音频线程创建 sink 时沿用
+    m_outputDevice = QMediaDevices::defaultAudioOutput();
+
+    // 优先 16 位立体声，采样率跟随设备；设备不支持时改用它的首选格式，由 mix() 转换
+    m_format.setSampleRate(m_outputDevice.isNull() ? 48000 : m_outputDevice.preferredFormat().sampleRate());
+    m_format.setChannelCount(2);
+    m_format.setSampleFormat(QAudioFormat::Int16);
+    if (!m_outputDevice.isNull() && !m_outputDevice.isFormatSupported(m_format))
+    {
+        m_format = m_outputDevice.preferredFormat();
+        qDebug() << "音频设备不支持 16 位立体声，改用首选格式:" << m_format;
+    }
+}
+
+AudioMixer::~AudioMixer()
+{
+    stop();
+}
+
+int AudioMixer::addSound(const QString &path, int maxVoices, float volume)
+{
+    TraceScope trace("asset", "load sound");
+
+    // 资源包里是烘焙好的 PCM，没有时读 WAV 原文件
+    AssetPack::Sound pcm = AssetPack::sound(path);
+    QByteArray fileData, decoded;
+    if (pcm.isNull())
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            qWarning() << "无法加载音效 (资源包与原文件都没有):" << path;
+            return -1;
+        }
+        fileData = file.readAll();
+        if (!AssetPack::decodeWav(fileData, pcm, decoded))
+        {
+            qWarning() << "无法解析音效，只支持整数 PCM WAV:" << path;
+            return -1;
+        }
+    }
+
+    Sound sound;
+    sound.samples = convert(pcm, m_format.sampleRate());
+    sound.maxVoices = qBound(1, maxVoices, (int)MAX_VOICES);
+    sound.volume = volume;
+    if (sound.samples.isEmpty())
+    {
+        qWarning() << "不支持的音效格式 (只支持 8 / 16 位):" << path;
+        return -1;
+    }
+    m_sounds.append(sound);
+    return m_sounds.size() - 1;
+}
+
+void AudioMixer::start()
+{
+    if (m_thread)
+        return;
+
+    m_accumulator.resize(m_format.sampleRate() * 2); // 1 秒，足够任何一次取数
+
+    m_thread = new QThread(this);
+    m_thread->setObjectName("AudioMixer");
+    m_context = new QObject;
+    m_context->moveToThread(m_thread);
+    m_thread->start(QThread::TimeCriticalPriority);
+
+    // sink 在音频线程里创建，拉模式的 readData 也就在音频线程里被调用
+    QMetaObject::invokeMethod(m_context, [this]()
+                              {
+        m_device = new MixerDevice(this);
+        m_device->open(QIODevice::ReadOnly);
+        m_sink = new QAudioSink(m_outputDevice, m_format);
+        m_sink->setBufferSize(m_format.bytesForDuration(BUFFER_MS * 1000));
+        m_sink->start(m_device); }, Qt::BlockingQueuedConnection);
+}
+
+void AudioMixer::stop()
+{
+    if (!m_thread)
+        return;
+
+    QMetaObject::invokeMethod(m_context, [this]()
+                              {
+        m_sink->stop();
+        delete m_sink;
+        m_sink = nullptr;
+        delete m_device;
+        m_device = nullptr; }, Qt::BlockingQueuedConnection);
+
+    m_thread->quit();
+    m_thread->wait();
+
+    // 音频线程已停：清空声部与未处理的触发，下次 start() 从静音开始
+    for (Voice &v : m_voices)
+        v = Voice();
+    m_head.store(m_tail.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_startCounter = 0;
+
+    delete m_context;
+    m_context = nullptr;
+    delete m_thread;
+    m_thread = nullptr;
+}
+
+void AudioMixer::play(int soundId)
+{
+    if (soundId < 0 || soundId >= m_sounds.size())
+        return;
+    const quint32 tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) >= (quint32)QUEUE_SIZE)
+        return; // 队列满 (音频线程卡住)，丢弃
+    m_queue[tail & (QUEUE_SIZE - 1)] = soundId;
+    m_tail.store(tail + 1, std::memory_order_release);
+}
+
+// ================= 音频线程 =================
+void AudioMixer::drainTriggers()
+{
+    quint32 head = m_head.load(std::memory_order_relaxed);
+    const quint32 tail = m_tail.load(std::memory_order_acquire);
+    while (head != tail)
+    {
+        startVoice(m_queue[head & (QUEUE_SIZE - 1)]);
+        head++;
+    }
+    m_head.store(head, std::memory_order_release);
+}
+
+void AudioMixer::startVoice(int soundId)
+{
+    // 选声部：该音效已到并发上限时抢占它最早的声部；否则用空闲声部；池满时抢占全局最早的声部
+    int sameCount = 0, oldestSame = -1, freeVoice = -1, oldestAny = 0;
+    for (int i = 0; i < MAX_VOICES; ++i)
+    {
+        const Voice &v = m_voices[i];
+        if (v.sound < 0)
+        {
+            if (freeVoice < 0)
+                freeVoice = i;
+            continue;
+        }
+        if (v.sound == soundId)
+        {
+            sameCount++;
+            if (oldestSame < 0 || v.startOrder < m_voices[oldestSame].startOrder)
+                oldestSame = i;
+        }
+        if (m_voices[oldestAny].sound < 0 || v.startOrder < m_voices[oldestAny].startOrder)
+            oldestAny = i;
+    }
+
+    int slot;
+    if (sameCount >= m_sounds[soundId].maxVoices)
+        slot = oldestSame;
+    else if (freeVoice >= 0)
+        slot = freeVoice;
+    else
+        slot = oldestAny;
+
+    m_voices[slot].sound = soundId;
+    m_voices[slot].position = 0;
+    m_voices[slot].startOrder = m_startCounter++;
+}
+
+int AudioMixer::mix(char *out, int frames)
+{
+    drainTriggers();
+
+    frames = qMin(frames, m_accumulator.size() / 2);
+    const int samples = frames * 2;
+    qint32 *acc = m_accumulator.data();
+    memset(acc, 0, samples * sizeof(qint32));
+
+    for (Voice &v : m_voices)
+    {
+        if (v.sound < 0)
+            continue;
+        const Sound &s = m_sounds[v.sound];
+        const int n = qMin(samples, s.samples.size() - v.position);
+        const qint32 gain = (qint32)(s.volume * 256); // 8 位定点音量
+        const qint16 *src = s.samples.constData() + v.position;
+        for (int i = 0; i < n; ++i)
+            acc[i] += (src[i] * gain) >> 8;
+        v.position += n;
+        if (v.position >= s.samples.size())
+            v.sound = -1;
+    }
+
+    // 立体声 -> 设备声道数 (单声道取平均，多出的声道静音) 与样本格式
+    const int channels = m_format.channelCount();
+    const int sampleBytes = m_format.bytesPerSample();
+    const QAudioFormat::SampleFormat sampleFormat = m_format.sampleFormat();
+    for (int f = 0; f < frames; ++f)
+    {
+        const qint32 left = qBound(-32768, acc[f * 2], 32767);
+        const qint32 right = qBound(-32768, acc[f * 2 + 1], 32767);
+        for (int c = 0; c < channels; ++c)
+        {
+            qint32 v;
+            if (channels == 1)
+                v = (left + right) / 2;
+            else
+                v = c == 0 ? left : (c == 1 ? right : 0);
+
+            char *dst = out + (f * channels + c) * sampleBytes;
+            switch (sampleFormat)
+            {
+            case QAudioFormat::UInt8:
+                *reinterpret_cast<quint8 *>(dst) = (quint8)((v >> 8) + 128);
+                break;
+            case QAudioFormat::Int32:
+            {
+                const qint32 s = v * 65536;
+                memcpy(dst, &s, sizeof(s));
+                break;
+            }
+            case QAudioFormat::Float:
+            {
+                const float s = v / 32768.0f;
+                memcpy(dst, &s, sizeof(s));
+                break;
+            }
+            default:
+            {
+                const qint16 s = (qint16)v;
+                memcpy(dst, &s, sizeof(s));
+                break;
+            }
+            }
+        }
+    }
+    return frames;
+}
@@ -0,0 +1,84 @@
+#ifndef AUDIOMIXER_H
+#define AUDIOMIXER_H
+
+#include <QAudioDevice>
+#include <QAudioFormat>
+#include <QIODevice>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <atomic>
+
+class QAudioSink;
+class QThread;
+
+// 音效混音器
+// 所有音效预先解成输出采样率的 16 位立体声 PCM；QAudioSink 在独立的音频线程里以拉模式取数，
+// 每次取数时把活动的声部 (固定声部池，MAX_VOICES 个) 叠加混合，再转换成设备的声道数 / 样本格式交给声卡。
+// 输出设备在构造时 (GUI 线程) 选定一次；设备不支持 16 位立体声时改用设备的首选格式。
+// 游戏线程的 play() 只往无锁单生产者 / 单消费者环形队列里写一个编号，不分配内存、不加锁。
+// 每种音效有并发上限：超出时抢占该音效最早的声部，连发时声音重新起头而不是被吞掉。
+class AudioMixer : public QObject
+{
+    Q_OBJECT
+public:
+    static const int MAX_VOICES = 32;
+    static const int QUEUE_SIZE = 256; // 必须是 2 的幂
+    static const int BUFFER_MS = 20;   // 声卡缓冲，决定触发延迟
+
+    explicit AudioMixer(QObject *parent = nullptr);
+    ~AudioMixer();
+
+    // 加载音效 (start() 之前、GUI 线程)：优先取资源包里的 PCM，否则读 WAV 文件
+    // 返回音效编号，失败时输出警告并返回 -1 (之后 play(-1) 什么也不做)
+    int addSound(const QString &path, int maxVoices, float volume);
+
+    void start();
+    void stop();
+
+    // 任意单一线程调用 (游戏线程)；队列满时丢弃本次触发
+    void play(int soundId);
+
+private:
+    class MixerDevice;
+
+    struct Sound
+    {
+        QVector<qint16> samples; // 交错立体声
+        int maxVoices;
+        float volume;
+    };
+
+    struct Voice
+    {
+        int sound = -1; // -1 表示空闲
+        int position = 0;
+        quint32 startOrder = 0; // 越小越早开始，抢占时选它
+    };
+
+    // 以下在音频线程里调用
+    int mix(char *out, int frames); // out 按 m_format 排列，返回实际写入的帧数
+    void drainTriggers();
+    void startVoice(int soundId);
+
+    QAudioDevice m_outputDevice;
+    QAudioFormat m_format;
+    QVector<Sound> m_sounds; // start() 之后只读
+
+    // 触发队列：play() 写 tail，音频线程读 head
+    int m_queue[QUEUE_SIZE];
+    std::atomic<quint32> m_head{0};
+    std::atomic<quint32> m_tail{0};
+
+    // 只在音频线程访问
+    Voice m_voices[MAX_VOICES];
+    quint32 m_startCounter = 0;
+    QVector<qint32> m_accumulator; // 交错立体声
+
+    QThread *m_thread = nullptr;
+    QObject *m_context = nullptr; // 住在音频线程里，用来把 sink 的创建 / 销毁派发过去
+    QAudioSink *m_sink = nullptr;
+    MixerDevice *m_device = nullptr;
+};
+
+#endif // AUDIOMIXER_H
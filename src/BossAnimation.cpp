@@ -0,0 +1,106 @@
+#include "BossAnimation.h"
+#include "TraceRecorder.h"
+#include <QImageReader>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <QtMath>
+
+namespace
+{
+    const int DEFAULT_FRAME_DELAY = 100; // GIF 未写帧间隔时按 100ms
+}
+
+BossAnimation::BossAnimation()
+    : m_totalMs(0)
+{
+}
+
+BossAnimation::~BossAnimation()
+{
+    clear();
+}
+
+void BossAnimation::load(const QString &path, const QSize &logicalSize, qreal deviceScale)
+{
+    clear();
+
+    const QSize pixelSize(qMax(1, qCeil(logicalSize.width() * deviceScale)),
+                          qMax(1, qCeil(logicalSize.height() * deviceScale)));
+    std::shared_ptr<Decoded> state = std::make_shared<Decoded>();
+    m_pending = state;
+    QThreadPool::globalInstance()->start([state, path, pixelSize]()
+                                         { decode(state, path, pixelSize); });
+}
+
+void BossAnimation::clear()
+{
+    if (m_pending)
+    {
+        m_pending->cancelled = true; // 工作线程下一帧时退出，结果随共享指针释放
+        m_pending.reset();
+    }
+    m_frames.clear();
+    m_frameEndMs.clear();
+    m_totalMs = 0;
+}
+
+// 工作线程：逐帧解码 -> 缩放到显示尺寸 -> 转成预乘格式 (贴图时不再转换)
+void BossAnimation::decode(const std::shared_ptr<Decoded> &state, const QString &path, const QSize &pixelSize)
+{
+    const QByteArray detail = path.toUtf8();
+    TraceScope trace("asset", "decode boss gif", detail.constData());
+
+    QVector<QImage> frames;
+    QVector<int> delays;
+    QImageReader reader(path);
+    QImage image;
+    while (!state->cancelled && reader.read(&image))
+    {
+        frames.append(image.scaled(pixelSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                          .convertToFormat(QImage::Format_ARGB32_Premultiplied));
+        const int delay = reader.nextImageDelay();
+        delays.append(delay > 0 ? delay : DEFAULT_FRAME_DELAY);
+    }
+
+    QMutexLocker locker(&state->mutex);
+    state->frames = frames;
+    state->delays = delays;
+    state->done = true;
+}
+
+// GUI 线程：解码完成后取回结果并转成 QPixmap (QPixmap 只能在 GUI 线程创建)
+void BossAnimation::collect()
+{
+    QVector<QImage> frames;
+    QVector<int> delays;
+    {
+        QMutexLocker locker(&m_pending->mutex);
+        if (!m_pending->done)
+            return;
+        frames.swap(m_pending->frames);
+        delays.swap(m_pending->delays);
+    }
+    m_pending.reset();
+
+    m_totalMs = 0;
+    for (int i = 0; i < frames.size(); ++i)
+    {
+        m_frames.append(QPixmap::fromImage(frames[i]));
+        m_totalMs += delays[i];
+        m_frameEndMs.append(m_totalMs);
+    }
+}
+
+const QPixmap *BossAnimation::frameAt(double elapsedMs)
+{
+    if (m_pending)
+        collect();
+    if (m_frames.isEmpty())
+        return nullptr;
+
+    const int t = (int)elapsedMs % m_totalMs;
+    int index = 0;
+    while (index < m_frameEndMs.size() - 1 && t >= m_frameEndMs[index])
+        index++;
+    return &m_frames[index];
+}
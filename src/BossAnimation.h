@@ -0,0 +1,49 @@
+#ifndef BOSSANIMATION_H
+#define BOSSANIMATION_H
+
+#include <QImage>
+#include <QMutex>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <memory>
+
+// BOSS 动画帧
+// 关卡加载时在线程池里把 GIF 全部解码，并直接缩放到屏幕上的显示尺寸 (设备像素)，
+// 绘制时按逻辑帧时间取现成的帧贴图，不再在 GUI 线程解码，也不再每帧平滑缩放。
+class BossAnimation
+{
+public:
+    BossAnimation();
+    ~BossAnimation();
+
+    // 后台解码 path 的全部帧，缩放到 logicalSize x deviceScale 像素；再次调用会作废上一次的结果
+    void load(const QString &path, const QSize &logicalSize, qreal deviceScale);
+    void clear();
+
+    // 取播放到 elapsedMs 毫秒时的帧 (循环播放)；后台尚未解码完成或没有动画时返回 nullptr
+    const QPixmap *frameAt(double elapsedMs);
+
+private:
+    // 工作线程与 GUI 线程共享的解码结果 (工作线程只持有它，不持有 BossAnimation 本身)
+    struct Decoded
+    {
+        QMutex mutex;
+        bool done = false;
+        QVector<QImage> frames;
+        QVector<int> delays; // 每帧停留毫秒数
+        std::atomic<bool> cancelled{false};
+    };
+
+    static void decode(const std::shared_ptr<Decoded> &state, const QString &path, const QSize &pixelSize);
+    void collect();
+
+    std::shared_ptr<Decoded> m_pending; // 正在解码 (为空表示已取回或没有任务)
+    QVector<QPixmap> m_frames;
+    QVector<int> m_frameEndMs; // 每帧结束时刻 (前缀和)
+    int m_totalMs;
+};
+
+#endif // BOSSANIMATION_H
@@ -1,20 +1,45 @@
 #include "BossStrategy.h"
 #include <QtMath>
-#include <QRandomGenerator>
 
 BossStrategy::BossStrategy()
+    : emissionMultiplier(1)
 {
     reset();
 }
 
+void BossStrategy::setEmissionMultiplier(int multiplier)
+{
+    emissionMultiplier = multiplier < 1 ? 1 : multiplier;
+}
+
+const char *BossStrategy::stateName(BossState state)
+{
+    switch (state)
+    {
+    case STATE_NORMAL:
+        return "STATE_NORMAL";
+    case STATE_WARNING:
+        return "STATE_WARNING";
+    case STATE_SKILL_DASH:
+        return "STATE_SKILL_DASH";
+    case STATE_SKILL_FIRE:
+        return "STATE_SKILL_FIRE";
+    case STATE_RECOVERY:
+        return "STATE_RECOVERY";
+    default:
+        return "STATE_UNKNOWN";
+    }
+}
+
 void BossStrategy::reset()
 {
     bossTime = 0;
     bossAttackAngle = 0;
     bossTargetPos = QPointF(-1, -1);
+    lastTeleportCheck = 0;
 }
 
-void BossStrategy::update(Enemy &boss, QList<Bullet> &bullets,
+void BossStrategy::update(Enemy &boss, BulletStore &bullets, GameRandom &rng,
                           double heroX, double heroY,
                           int width, int height,
                           const LevelConfig &config)
@@ -47,7 +72,6 @@ void BossStrategy::update(Enemy &boss, QList<Bullet> &bullets,
         // Level 6 & Level 4 (高机动型BOSS) 使用瞬移或大幅度机动
         if (boss.bossId == 6 || boss.bossId == 4)
         {
-            static double lastTeleportCheck = 0;
             // 狂暴后瞬移频率极高 (1.5秒一次)
             double teleportCD = isEnraged ? 1.5 : 3.0;
 
@@ -56,8 +80,8 @@ void BossStrategy::update(Enemy &boss, QList<Bullet> &bullets,
                 lastTeleportCheck = bossTime;
 
                 // 随机移动到玩家头顶附近，而不是随机乱飞
-                double targetX = heroX + QRandomGenerator::global()->bounded(200) - 100;
-                double targetY = QRandomGenerator::global()->bounded(50, (int)(height * 0.4));
+                double targetX = heroX + rng.bounded(200) - 100;
+                double targetY = rng.bounded(50, (int)(height * 0.4));
 
                 // 边界限制
                 if (targetX < 50)
@@ -78,10 +102,10 @@ void BossStrategy::update(Enemy &boss, QList<Bullet> &bullets,
                 dist = qSqrt(qPow(boss.x - bossTargetPos.x(), 2) + qPow(boss.y - bossTargetPos.y(), 2));
             }
             // 更加频繁地更换位置，让玩家难以瞄准
-            if (bossTargetPos.x() < 0 || dist < 30 || QRandomGenerator::global()->bounded(100) < 3)
+            if (bossTargetPos.x() < 0 || dist < 30 || rng.bounded(100) < 3)
             {
-                double randX = QRandomGenerator::global()->bounded(20, width - 220);
-                double randY = QRandomGenerator::global()->bounded(20, (int)(height * 0.35));
+                double randX = rng.bounded(20, width - 220);
+                double randY = rng.bounded(20, (int)(height * 0.35));
                 bossTargetPos = QPointF(randX, randY);
             }
         }
@@ -93,6 +117,9 @@ void BossStrategy::update(Enemy &boss, QList<Bullet> &bullets,
     // === 3. 攻击逻辑 (地狱绘图开始) ===
     boss.shootTimer++;
 
+    // 压力倍率：环形 / 扇形弹按倍率加密；单发弹追加副本 (第 0 发与正常弹幕完全一致)
+    const int m = emissionMultiplier;
+
     // ---------------------------------------------------------
     // Level 1: 狙击手 -> 改为 "光束刺客"
     // 技能：不仅冲撞，冲撞路径上还会残留子弹
@@ -136,15 +163,10 @@ void BossStrategy::update(Enemy &boss, QList<Bullet> &bullets,
             // 【新机制】冲刺路径撒雷
             if (boss.skillTimer % 2 == 0)
             {
-                Bullet b;
-                b.x = boss.x + 100;
-                b.y = boss.y + 100;
-                b.active = true;
-                b.isEnemy = true;
-                b.speedX = 0;
-                b.speedY = 0;       // 这是一个地雷，不动
-                b.isSpecial = true; // 特殊外观
-                bullets.append(b);
+                // 这是一个地雷，不动；特殊外观
+                for (int c = 0; c < m; c++)
+                    bullets.add(boss.x + 100 + c * 12, boss.y + 100, 0, 0,
+                                BulletStore::FLAG_ENEMY | BulletStore::FLAG_SPECIAL);
             }
 
             boss.skillTimer++;
@@ -167,20 +189,14 @@ void BossStrategy::update(Enemy &boss, QList<Bullet> &bullets,
             if (boss.shootTimer > rate)
             {
                 boss.shootTimer = 0;
-                int count = isEnraged ? 7 : 5; // 狂暴7发扇形
+                int count = (isEnraged ? 7 : 5) * m; // 狂暴7发扇形
                 double startAngle = 60.0;
                 double step = 60.0 / (count - 1);
                 for (int i = 0; i < count; i++)
                 {
-                    Bullet b;
-                    b.x = boss.x + 100;
-                    b.y = boss.y + 150;
-                    b.active = true;
-                    b.isEnemy = true;
                     double rad = qDegreesToRadians(startAngle + i * step);
-                    b.speedX = qCos(rad) * 9.0;
-                    b.speedY = qSin(rad) * 9.0;
-                    bullets.append(b);
+                    bullets.add(boss.x + 100, boss.y + 150, qCos(rad) * 9.0, qSin(rad) * 9.0,
+                                BulletStore::FLAG_ENEMY);
                 }
             }
         }
@@ -200,43 +216,31 @@ void BossStrategy::update(Enemy &boss, QList<Bullet> &bullets,
             // 扫射逻辑：左右摇摆
             double sweep = 45.0 * qSin(bossTime * 3.0);
 
-            // 左炮：慢速大球
-            Bullet b1;
-            b1.x = boss.x;
-            b1.y = boss.y + 100;
-            b1.active = true;
-            b1.isEnemy = true;
-            b1.isSpecial = true;
-            double r1 = qDegreesToRadians(90.0 + sweep);
-            b1.speedX = qCos(r1) * 5.0;
-            b1.speedY = qSin(r1) * 5.0;
-            bullets.append(b1);
-
-            // 右炮：高速小弹
-            Bullet b2;
-            b2.x = boss.x + 200;
-            b2.y = boss.y + 100;
-            b2.active = true;
-            b2.isEnemy = true;
-            double r2 = qDegreesToRadians(90.0 - sweep);
-            b2.speedX = qCos(r2) * 9.0;
-            b2.speedY = qSin(r2) * 9.0;
-            bullets.append(b2);
+            for (int c = 0; c < m; c++)
+            {
+                // 副本向两侧交替偏转 3 度
+                double offset = (c % 2 ? 3.0 : -3.0) * ((c + 1) / 2);
+
+                // 左炮：慢速大球
+                double r1 = qDegreesToRadians(90.0 + sweep + offset);
+                bullets.add(boss.x, boss.y + 100, qCos(r1) * 5.0, qSin(r1) * 5.0,
+                            BulletStore::FLAG_ENEMY | BulletStore::FLAG_SPECIAL);
+
+                // 右炮：高速小弹
+                double r2 = qDegreesToRadians(90.0 - sweep + offset);
+                bullets.add(boss.x + 200, boss.y + 100, qCos(r2) * 9.0, qSin(r2) * 9.0,
+                            BulletStore::FLAG_ENEMY);
+            }
 
             // 狂暴：全屏炸裂
             if (isEnraged && (int)(bossTime * 10) % 15 == 0)
             {
-                for (int k = 0; k < 12; k++)
+                const int burst = 12 * m;
+                for (int k = 0; k < burst; k++)
                 {
-                    Bullet b;
-                    b.x = boss.x + 100;
-                    b.y = boss.y + 100;
-                    b.active = true;
-                    b.isEnemy = true;
-                    double rad = qDegreesToRadians(k * 30.0 + bossAttackAngle);
-                    b.speedX = qCos(rad) * 6.0;
-                    b.speedY = qSin(rad) * 6.0;
-                    bullets.append(b);
+                    double rad = qDegreesToRadians(k * (360.0 / burst) + bossAttackAngle);
+                    bullets.add(boss.x + 100, boss.y + 100, qCos(rad) * 6.0, qSin(rad) * 6.0,
+                                BulletStore::FLAG_ENEMY);
                 }
             }
         }
@@ -254,18 +258,12 @@ void BossStrategy::update(Enemy &boss, QList<Bullet> &bullets,
             boss.shootTimer = 0;
 
             // 顺时针螺旋
-            int arms = isEnraged ? 4 : 3;
+            int arms = (isEnraged ? 4 : 3) * m;
             for (int k = 0; k < arms; k++)
             {
-                Bullet b;
-                b.x = boss.x + 100;
-                b.y = boss.y + 100;
-                b.active = true;
-                b.isEnemy = true;
                 double rad = qDegreesToRadians(bossAttackAngle + k * (360.0 / arms));
-                b.speedX = qCos(rad) * 6.0;
-                b.speedY = qSin(rad) * 6.0;
-                bullets.append(b);
+                bullets.add(boss.x + 100, boss.y + 100, qCos(rad) * 6.0, qSin(rad) * 6.0,
+                            BulletStore::FLAG_ENEMY);
             }
 
             // 狂暴：叠加逆时针螺旋
@@ -273,16 +271,10 @@ void BossStrategy::update(Enemy &boss, QList<Bullet> &bullets,
             {
                 for (int k = 0; k < arms; k++)
                 {
-                    Bullet b;
-                    b.x = boss.x + 100;
-                    b.y = boss.y + 100;
-                    b.active = true;
-                    b.isEnemy = true;
-                    b.isSpecial = true; // 特殊颜色区分
                     double rad = qDegreesToRadians(-bossAttackAngle * 1.5 + k * (360.0 / arms));
-                    b.speedX = qCos(rad) * 7.0;
-                    b.speedY = qSin(rad) * 7.0;
-                    bullets.append(b);
+                    // 特殊颜色区分
+                    bullets.add(boss.x + 100, boss.y + 100, qCos(rad) * 7.0, qSin(rad) * 7.0,
+                                BulletStore::FLAG_ENEMY | BulletStore::FLAG_SPECIAL);
                 }
             }
         }
@@ -304,7 +296,7 @@ void BossStrategy::update(Enemy &boss, QList<Bullet> &bullets,
                 boss.state = STATE_WARNING;
                 boss.isWarning = true;
                 // 随机生成 3-4 个轰炸条，只有一个空隙
-                boss.attackTargetX = QRandomGenerator::global()->bounded(width); // 记录空隙位置X
+                boss.attackTargetX = rng.bounded(width); // 记录空隙位置X
 
                 // 构造一个全屏宽度的警告矩形，视觉上由GameWidget去画多条红带
                 // 为了简单，我们只标记要轰炸的状态，具体子弹生成在下一阶段
@@ -328,19 +320,16 @@ void BossStrategy::update(Enemy &boss, QList<Bullet> &bullets,
             int gapX = (int)boss.attackTargetX;
             int gapWidth = 120; // 安全区宽度
 
-            for (int i = 0; i < width; i += 25)
-            { // 每25像素一颗子弹
+            // 每25像素一颗子弹 (压力模式间距按 25 / 倍率 加密，弹数严格为 m 倍)
+            const double spacing = 25.0 / m;
+            for (int k = 0; k * spacing < width; ++k)
+            {
+                const double i = k * spacing;
                 if (i > gapX - gapWidth / 2 && i < gapX + gapWidth / 2)
                     continue; // 留出空隙
 
-                Bullet b;
-                b.x = i;
-                b.y = -20;
-                b.active = true;
-                b.isEnemy = true;
-                b.speedX = 0;
-                b.speedY = isEnraged ? 12.0 : 8.0; // 高速下落
-                bullets.append(b);
+                // 高速下落
+                bullets.add(i, -20, 0, isEnraged ? 12.0 : 8.0, BulletStore::FLAG_ENEMY);
             }
             boss.state = STATE_NORMAL; // 立即开始下一轮循环
         }
@@ -349,18 +338,15 @@ void BossStrategy::update(Enemy &boss, QList<Bullet> &bullets,
         if (boss.shootTimer++ > 30)
         {
             boss.shootTimer = 0;
-            Bullet b;
-            b.x = boss.x + 100;
-            b.y = boss.y + 150;
-            b.active = true;
-            b.isEnemy = true;
-            b.isSpecial = true;
-            double dx = heroX - b.x;
-            double dy = heroY - b.y;
+            double bx = boss.x + 100;
+            double by = boss.y + 150;
+            double dx = heroX - bx;
+            double dy = heroY - by;
             double dist = qSqrt(dx * dx + dy * dy);
-            b.speedX = (dx / dist) * 6.0;
-            b.speedY = (dy / dist) * 6.0;
-            bullets.append(b);
+            // 副本沿同一方向逐发提速，形成一串
+            for (int c = 0; c < m; c++)
+                bullets.add(bx, by, (dx / dist) * 6.0 * (1.0 + c * 0.05), (dy / dist) * 6.0 * (1.0 + c * 0.05),
+                            BulletStore::FLAG_ENEMY | BulletStore::FLAG_SPECIAL);
         }
     }
 
@@ -375,47 +361,36 @@ void BossStrategy::update(Enemy &boss, QList<Bullet> &bullets,
             boss.shootTimer = 0;
 
             // 1. 核心散射 (旋转)
-            for (int k = 0; k < 5; k++)
+            const int spokes = 5 * m;
+            for (int k = 0; k < spokes; k++)
             {
-                Bullet b;
-                b.x = boss.x + 100;
-                b.y = boss.y + 100;
-                b.active = true;
-                b.isEnemy = true;
-                double rad = qDegreesToRadians(bossAttackAngle + k * 72.0);
-                b.speedX = qCos(rad) * 7.0;
-                b.speedY = qSin(rad) * 7.0;
-                bullets.append(b);
+                double rad = qDegreesToRadians(bossAttackAngle + k * (360.0 / spokes));
+                bullets.add(boss.x + 100, boss.y + 100, qCos(rad) * 7.0, qSin(rad) * 7.0,
+                            BulletStore::FLAG_ENEMY);
             }
 
             // 2. 追踪弹 (每隔几次)
             if ((int)(bossTime * 10) % 5 == 0)
             {
-                Bullet b;
-                b.x = boss.x + 100;
-                b.y = boss.y + 100;
-                b.active = true;
-                b.isEnemy = true;
-                b.isSpecial = true;
-                double dx = heroX - b.x;
-                double dy = heroY - b.y;
+                double bx = boss.x + 100;
+                double by = boss.y + 100;
+                double dx = heroX - bx;
+                double dy = heroY - by;
                 double dist = qSqrt(dx * dx + dy * dy);
-                b.speedX = (dx / dist) * 11.0;
-                b.speedY = (dy / dist) * 11.0;
-                bullets.append(b);
+                for (int c = 0; c < m; c++)
+                    bullets.add(bx, by, (dx / dist) * 11.0 * (1.0 + c * 0.05), (dy / dist) * 11.0 * (1.0 + c * 0.05),
+                                BulletStore::FLAG_ENEMY | BulletStore::FLAG_SPECIAL);
             }
 
             // 3. Level 6 专属：全屏随机弹 (让场面更乱)
             if (boss.bossId == 6 && isEnraged)
             {
-                Bullet b;
-                b.x = QRandomGenerator::global()->bounded(width);
-                b.y = -10;
-                b.active = true;
-                b.isEnemy = true;
-                b.speedX = (QRandomGenerator::global()->bounded(10) - 5) / 2.0;
-                b.speedY = 6.0;
-                bullets.append(b);
+                for (int c = 0; c < m; c++)
+                {
+                    double bx = rng.bounded(width);
+                    double speedX = (rng.bounded(10) - 5) / 2.0;
+                    bullets.add(bx, -10, speedX, 6.0, BulletStore::FLAG_ENEMY);
+                }
             }
         }
     }
@@ -2,6 +2,8 @@
 #define BOSSSTRATEGY_H
 
 #include "common.h"
+#include "BulletStore.h"
+#include "GameRandom.h"
 #include <QList>
 #include <QPointF>
 
@@ -13,9 +15,16 @@ public:
     // 重置状态（每次新关卡开始时调用）
     void reset();
 
+    // 压力测试：每次发射的弹数乘以 multiplier (1 为正常弹幕)
+    void setEmissionMultiplier(int multiplier);
+
+    // 状态名 (调试 / 事件追踪用)
+    static const char *stateName(BossState state);
+
     // 核心更新函数
     void update(Enemy &boss,
-                QList<Bullet> &bullets,
+                BulletStore &bullets,
+                GameRandom &rng,
                 double heroX, double heroY,
                 int screenWidth, int screenHeight,
                 const LevelConfig &config);
@@ -24,6 +33,8 @@ private:
     double bossTime;
     double bossAttackAngle;
     QPointF bossTargetPos; // 用于随机航点移动
+    double lastTeleportCheck; // 上次瞬移的 bossTime (Level 4 / 6)
+    int emissionMultiplier;   // 弹数倍率 (不随 reset 清除)
 };
 
 #endif // BOSSSTRATEGY_H
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "BulletSprites.h"
+#include <QLinearGradient>
+#include <QRadialGradient>
+#include <QtMath>
+
+// ================= 各外观的绘制 (子弹坐标为原点，与原 paintEvent 中的图元完全一致) =================
+namespace
+{
+    void paintEnemyNormal(QPainter &p)
+    {
+        QRadialGradient gradient(4, 4, 6);
+        gradient.setColorAt(0.0, QColor(255, 255, 255));
+        gradient.setColorAt(0.5, QColor(255, 0, 0));
+        gradient.setColorAt(1.0, QColor(100, 0, 0, 0));
+        p.setBrush(gradient);
+        p.drawEllipse(0, 0, 10, 10);
+    }
+
+    void paintEnemySpecial(QPainter &p)
+    {
+        QRadialGradient gradient(10, 10, 15);
+        gradient.setColorAt(0.0, Qt::white);
+        gradient.setColorAt(0.5, QColor(0, 255, 255));
+        gradient.setColorAt(1.0, QColor(0, 0, 255, 0));
+        p.setBrush(gradient);
+        p.drawEllipse(0, 0, 20, 20);
+    }
+
+    void paintPlayerDefault(QPainter &p)
+    {
+        QLinearGradient g(0, 0, 0, 15);
+        g.setColorAt(0, QColor(255, 255, 200));
+        g.setColorAt(1, QColor(255, 165, 0));
+        p.setBrush(g);
+        p.drawRect(2, 0, 4, 14);
+    }
+
+    void paintPlayerDouble(QPainter &p)
+    {
+        QRadialGradient g(4, 6, 8);
+        g.setColorAt(0, Qt::white);
+        g.setColorAt(0.6, QColor(0, 200, 255));
+        g.setColorAt(1, QColor(0, 0, 255, 0));
+        p.setBrush(g);
+        p.drawEllipse(0, 0, 8, 12);
+    }
+
+    void paintPlayerShotgun(QPainter &p)
+    {
+        QRadialGradient g(5, 5, 6);
+        g.setColorAt(0, Qt::white);
+        g.setColorAt(0.5, QColor(255, 50, 0));
+        g.setColorAt(1, QColor(100, 0, 0, 0));
+        p.setBrush(g);
+        p.drawEllipse(0, 0, 10, 10);
+    }
+
+    void paintPlayerSniper(QPainter &p)
+    {
+        p.setBrush(QColor(200, 0, 255, 100));
+        p.drawRect(1, -5, 6, 25);
+        p.setBrush(Qt::white);
+        p.drawRect(3, 0, 2, 20);
+    }
+
+    void paintPlayerAlien(QPainter &p)
+    {
+        QRadialGradient g(4, 4, 6);
+        g.setColorAt(0, QColor(200, 255, 200));
+        g.setColorAt(0.5, QColor(0, 255, 0));
+        g.setColorAt(1, QColor(0, 50, 0, 0));
+        p.setBrush(g);
+        p.drawEllipse(0, 0, 8, 8);
+    }
+
+    struct Look
+    {
+        QRectF bounds; // 图元包围盒 (逻辑像素，相对子弹坐标)
+        void (*paint)(QPainter &);
+    };
+
+    // 下标与 BulletSprites::Kind 对应
+    const Look LOOKS[BulletSprites::KIND_COUNT] = {
+        {QRectF(0, 0, 10, 10), paintEnemyNormal},
+        {QRectF(0, 0, 20, 20), paintEnemySpecial},
+        {QRectF(2, 0, 4, 14), paintPlayerDefault},   // PLANE_DEFAULT
+        {QRectF(0, 0, 8, 12), paintPlayerDouble},    // PLANE_DOUBLE
+        {QRectF(0, 0, 10, 10), paintPlayerShotgun},  // PLANE_SHOTGUN
+        {QRectF(1, -5, 6, 25), paintPlayerSniper},   // PLANE_SNIPER
+        {QRectF(0, 0, 8, 8), paintPlayerAlien},      // PLANE_ALIEN
+    };
+
+    const QSize PLAYER_IMAGE_BOX(20, 40); // 战机子弹贴图的逻辑尺寸上限 (保持比例)
+    const QPointF PLAYER_IMAGE_OFFSET(-5, 0);
+}
+
+BulletSprites::BulletSprites()
+{
+    for (int kind = 0; kind < KIND_COUNT; ++kind)
+        m_spriteIds[kind] = -1;
+}
+
+void BulletSprites::setPlayerImage(int planeId, const QImage &image)
+{
+    if (planeId < 0 || planeId >= KIND_COUNT - PLAYER_FIRST)
+        return;
+    m_playerImages[planeId] = image;
+}
+
+void BulletSprites::addToAtlas(SpriteAtlas &atlas, qreal deviceScale)
+{
+    for (int kind = 0; kind < KIND_COUNT; ++kind)
+    {
+        const int planeId = kind - PLAYER_FIRST;
+        if (planeId >= 0 && !m_playerImages[planeId].isNull())
+        {
+            // 从原图直接缩放到设备分辨率 (由图集完成)，而不是先缩到逻辑尺寸再被放大
+            const QSize logical = m_playerImages[planeId].size().scaled(PLAYER_IMAGE_BOX, Qt::KeepAspectRatio);
+            m_spriteIds[kind] = atlas.add(m_playerImages[planeId], logical, deviceScale, PLAYER_IMAGE_OFFSET);
+        }
+        else
+        {
+            const QRectF &bounds = LOOKS[kind].bounds;
+            m_spriteIds[kind] = atlas.add(render(bounds, LOOKS[kind].paint, deviceScale), bounds.size(),
+                                          deviceScale, bounds.topLeft());
+        }
+    }
+}
+
+QImage BulletSprites::render(const QRectF &bounds, void (*paint)(QPainter &), qreal deviceScale)
+{
+    const QSize size(qCeil(bounds.width() * deviceScale), qCeil(bounds.height() * deviceScale));
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    {
+        QPainter p(&image);
+        p.scale(deviceScale, deviceScale);
+        p.translate(-bounds.topLeft());
+        p.setPen(Qt::NoPen);
+        paint(p);
+    }
+    return image;
+}
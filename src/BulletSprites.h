@@ -0,0 +1,44 @@
+#ifndef BULLETSPRITES_H
+#define BULLETSPRITES_H
+
+#include "SpriteAtlas.h"
+#include <QImage>
+#include <QPainter>
+
+// 子弹精灵
+// 每种子弹外观 (敌方普通 / 敌方特殊 / 5 种战机子弹) 预先画成一张小图放进精灵图集，
+// 绘制时只做贴图，不再逐颗构造渐变画刷。
+// 小图按"逻辑缩放 x 设备像素比"的分辨率生成，缩放变化时随图集一起重建，贴到屏幕上始终 1:1 清晰。
+class BulletSprites
+{
+public:
+    enum Kind
+    {
+        ENEMY_NORMAL = 0,
+        ENEMY_SPECIAL,
+        PLAYER_FIRST, // PLAYER_FIRST + planeId
+        KIND_COUNT = PLAYER_FIRST + 5
+    };
+
+    static Kind playerKind(int planeId) { return (Kind)(PLAYER_FIRST + planeId); }
+
+    BulletSprites();
+
+    // 战机子弹贴图 (assets/bulletN.png 原图)，为空时使用程序绘制的默认外观
+    void setPlayerImage(int planeId, const QImage &image);
+
+    // 按 deviceScale (逻辑缩放 x devicePixelRatio) 生成全部外观并加入图集，记录各自的精灵编号
+    // 调用方负责之后的 atlas.build()
+    void addToAtlas(SpriteAtlas &atlas, qreal deviceScale);
+
+    // 图集中的精灵编号，绘制坐标与原先 drawEllipse / drawRect 的左上角约定一致
+    int spriteId(Kind kind) const { return m_spriteIds[kind]; }
+
+private:
+    static QImage render(const QRectF &bounds, void (*paint)(QPainter &), qreal deviceScale);
+
+    int m_spriteIds[KIND_COUNT];
+    QImage m_playerImages[KIND_COUNT - PLAYER_FIRST];
+};
+
+#endif // BULLETSPRITES_H
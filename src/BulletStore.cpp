@@ -0,0 +1,66 @@
+#include "BulletStore.h"
+
+BulletStore::BulletStore()
+    : m_count(0), m_capacity(0)
+{
+}
+
+void BulletStore::reserve(int capacity)
+{
+    m_count = 0;
+    if (capacity == m_capacity)
+        return;
+
+    m_capacity = capacity;
+    x.resize(capacity);
+    y.resize(capacity);
+    vx.resize(capacity);
+    vy.resize(capacity);
+    prevX.resize(capacity);
+    prevY.resize(capacity);
+    flags.resize(capacity);
+}
+
+int BulletStore::add(float px, float py, float speedX, float speedY, quint8 flagBits)
+{
+    if (m_count >= m_capacity)
+        return -1;
+
+    int i = m_count++;
+    x[i] = px;
+    y[i] = py;
+    vx[i] = speedX;
+    vy[i] = speedY;
+    prevX[i] = px;
+    prevY[i] = py;
+    flags[i] = flagBits | FLAG_ACTIVE;
+    return i;
+}
+
+void BulletStore::moveSlot(int from, int to)
+{
+    x[to] = x[from];
+    y[to] = y[from];
+    vx[to] = vx[from];
+    vy[to] = vy[from];
+    prevX[to] = prevX[from];
+    prevY[to] = prevY[from];
+    flags[to] = flags[from];
+}
+
+void BulletStore::removeInactive()
+{
+    int i = 0;
+    while (i < m_count)
+    {
+        if (flags[i] & FLAG_ACTIVE)
+        {
+            ++i;
+            continue;
+        }
+        // 末尾元素补到当前空位，i 不前进 (补过来的也可能已失活)
+        --m_count;
+        if (i != m_count)
+            moveSlot(m_count, i);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef BULLETSTORE_H
+#define BULLETSTORE_H
+
+#include <QVector>
+#include <QtGlobal>
+
+// 子弹容器 (SoA 布局 + 固定容量池)
+// 每个字段单独存放在连续数组中，移动 / 碰撞 / 绘制 / 清理各阶段只读写自己需要的字段。
+// 数组在 reserve() 时一次性分配到容量上限，之后的生成与回收都不再触碰堆内存；
+// 有效数据只在 [0, size()) 区间内，失活子弹由 removeInactive() 交换到末尾弹出。
+class BulletStore
+{
+public:
+    // 状态位 (flags 数组中每颗子弹一个字节)
+    enum Flag : quint8
+    {
+        FLAG_ENEMY = 0x01,   // 敌方子弹
+        FLAG_SPECIAL = 0x02, // 特殊技能弹幕 (绘制不同外观)
+        FLAG_ACTIVE = 0x04   // 存活
+    };
+
+    static const int DEFAULT_CAPACITY = 8192;
+
+    BulletStore();
+
+    int size() const { return m_count; }
+    int capacity() const { return m_capacity; }
+    bool isEmpty() const { return m_count == 0; }
+    bool isFull() const { return m_count >= m_capacity; }
+    void clear() { m_count = 0; }
+
+    // 设定容量上限并预分配 (会清空现有子弹)
+    void reserve(int capacity);
+
+    // 生成一颗子弹 (自动标记为存活)，返回下标；池满时丢弃并返回 -1
+    int add(float px, float py, float speedX, float speedY, quint8 flagBits);
+
+    bool isActive(int i) const { return flags[i] & FLAG_ACTIVE; }
+    bool isEnemy(int i) const { return flags[i] & FLAG_ENEMY; }
+    bool isSpecial(int i) const { return flags[i] & FLAG_SPECIAL; }
+    void kill(int i) { flags[i] &= ~FLAG_ACTIVE; }
+
+    // 移除所有失活子弹：用末尾元素填洞 (swap-and-pop)，每颗死亡子弹 O(1)，不保持顺序
+    void removeInactive();
+
+    // --- 数据 (下标一一对应，长度为 capacity()，只有前 size() 个有效) ---
+    QVector<float> x, y;         // 位置
+    QVector<float> vx, vy;       // 速度 (每逻辑帧)
+    QVector<float> prevX, prevY; // 上一逻辑帧位置 (插值渲染用)
+    QVector<quint8> flags;       // Flag 组合
+
+private:
+    void moveSlot(int from, int to);
+
+    int m_count;
+    int m_capacity;
+};
+
+#endif // BULLETSTORE_H
@@ -1,46 +1,86 @@
 #include "CollisionSystem.h"
+#include "SimdKernels.h"
 
 CollisionSystem::CollisionResult CollisionSystem::check(
+    Broadphase &broadphase,
+    double gameWidth, double gameHeight,
     double heroX, double heroY, int heroW, int heroH,
-    QList<Bullet> &bullets,
-    QList<Enemy> &enemies,
+    BulletStore &bullets,
+    EnemyPool &enemies,
+    const HitboxTable &hitboxes,
     bool isLaserActive,
     bool isShieldActive,
     int currentPlaneId,
+    int bulletDamage,
     int currentLevel,
     int totalWaves,
-    int &progressCounter,
-    const QImage &imgEnemy1,
-    const QImage &imgEnemy3)
+    int &progressCounter)
 {
     CollisionResult result = {0, false, false, false, 0};
 
-    QRect heroRect(heroX + 15, heroY + 15, heroW - 30, heroH - 30);
-    QRect laserRect(heroX + heroW / 2 - 40, 0, 80, heroY);
+    const Aabb heroRect = Hitbox{15, 15, (float)heroW - 30, (float)heroH - 30}.at(heroX, heroY);
+    const Aabb laserRect = Hitbox{(float)(heroW / 2 - 40), 0, 80, (float)heroY}.at(heroX, 0);
+    const float *bx = bullets.x.constData();
+    const float *by = bullets.y.constData();
+
+    // --- 0. 本帧碰撞盒缓存 + 粗筛网格 ---
+    SpatialGrid &enemyGrid = broadphase.enemyGrid;
+    enemyGrid.reset(gameWidth, gameHeight, CELL_SIZE);
+
+    if (broadphase.enemyHit.size() < enemies.capacity())
+    {
+        broadphase.enemyHit.resize(enemies.capacity());
+        broadphase.enemyBody.resize(enemies.capacity());
+        broadphase.enemyStamp.fill(0, enemies.capacity());
+    }
+    Aabb *enemyHit = broadphase.enemyHit.data();
+    Aabb *enemyBody = broadphase.enemyBody.data();
+
+    const int enemyCount = enemies.size();
+    for (int k = 0; k < enemyCount; ++k)
+    {
+        const Enemy &e = enemies[k];
+        if (!e.active)
+            continue;
+        enemyHit[k] = hitboxes.hitBox(e.type).at(e.x, e.y);
+        enemyBody[k] = hitboxes.bodyBox(e.type).at(e.x, e.y);
+        // 子弹框 [x, x + 8) 与受击框相交 <=> 子弹左上角落在向左上扩展 8 的区域内
+        const Aabb &r = enemyHit[k];
+        enemyGrid.insertRect(k, r.left - BULLET_SIZE, r.top - BULLET_SIZE, r.right, r.bottom);
+    }
+    enemyGrid.build();
+
+    // 敌方子弹不进网格：它们只和激光、英雄这两个框比较，直接对连续数组做向量化批量判定
+    const int bulletCount = bullets.size();
+    const quint8 *bflags = bullets.flags.constData();
+    const quint8 enemyBulletFlags = BulletStore::FLAG_ENEMY | BulletStore::FLAG_ACTIVE;
+    if (broadphase.bulletHits.size() < bullets.capacity())
+        broadphase.bulletHits.resize(bullets.capacity());
+    int *hits = broadphase.bulletHits.data();
 
     // --- 1. 激光判定 ---
     if (isLaserActive)
     {
-        for (auto &b : bullets)
-        {
-            if (b.isEnemy && b.active && laserRect.contains(b.x, b.y))
-            {
-                b.active = false;
-            }
-        }
-        for (auto &e : enemies)
-        {
+        // 子弹坐标落在激光柱内即被抹除 (点包含，与原 laserRect.contains 一致)
+        const int hitCount = SimdKernels::hitTest(bx, by, bflags, bulletCount, enemyBulletFlags,
+                                                  0, laserRect, 0, 0, 0, hits);
+        for (int h = 0; h < hitCount; ++h)
+            bullets.kill(hits[h]);
+
+        // 矩形查询可能多次访问同一敌人，用标记去重
+        const int stamp = ++broadphase.stamp;
+        enemyGrid.forEachInRect(laserRect.left, laserRect.top, laserRect.right, laserRect.bottom,
+                                [&](int k)
+                                {
+            if (broadphase.enemyStamp[k] == stamp)
+                return;
+            broadphase.enemyStamp[k] = stamp;
+
+            Enemy &e = enemies[k];
             if (!e.active)
-                continue;
-            QRect enemyRect;
-            if (e.type == 10)
-                enemyRect = QRect(e.x + 20, e.y + 20, 160, 110);
-            else if (e.type == 2)
-                enemyRect = QRect(e.x, e.y, imgEnemy3.width(), imgEnemy3.height());
-            else
-                enemyRect = QRect(e.x, e.y, imgEnemy1.width(), imgEnemy1.height());
+                return;
 
-            if (laserRect.intersects(enemyRect))
+            if (laserRect.intersects(enemyHit[k]))
             {
                 e.hp -= 2;
                 if (e.hp <= 0)
@@ -53,102 +93,74 @@ CollisionSystem::CollisionResult CollisionSystem::check(
                         result.bossDied = true;
                     result.scoreAdded += add;
                 }
-            }
-        }
+            } });
     }
 
     // --- 2. 子弹判定 (数值同步) ---
-    for (auto &b : bullets)
+    // 2.1 敌方子弹 vs 英雄 (开盾时护盾圆也算命中，子弹被吸收)
     {
-        if (!b.active)
-            continue;
-        QRect bulletRect(b.x, b.y, 8, 8);
-
-        if (b.isEnemy)
+        const float shieldR2 = isShieldActive ? (float)(SHIELD_RADIUS * SHIELD_RADIUS) : 0.0f;
+        const int hitCount = SimdKernels::hitTest(bx, by, bflags, bulletCount, enemyBulletFlags,
+                                                  BULLET_SIZE, heroRect,
+                                                  (float)(heroX + heroW / 2), (float)(heroY + heroH / 2), shieldR2,
+                                                  hits);
+        for (int h = 0; h < hitCount; ++h)
+            bullets.kill(hits[h]);
+        if (hitCount > 0 && !isShieldActive)
         {
-            if (heroRect.intersects(bulletRect))
-            {
-                b.active = false;
-                if (!isShieldActive)
-                {
-                    result.heroHit = true;
-                    result.heroDamageTaken += 1;
-                }
-            }
+            result.heroHit = true;
+            result.heroDamageTaken += hitCount;
         }
-        else
-        {
-            for (auto &e : enemies)
+    }
+
+    // 2.2 玩家子弹 vs 敌人：每颗子弹只检查自己所在格子里的敌人
+    for (int i = 0; i < bulletCount; ++i)
+    {
+        if (!bullets.isActive(i) || bullets.isEnemy(i))
+            continue;
+        const Aabb bulletRect = {bx[i], by[i], bx[i] + BULLET_SIZE, by[i] + BULLET_SIZE};
+
+        bool consumed = false;
+        enemyGrid.forEachInCell(bx[i], by[i], [&](int k)
+                                {
+            if (consumed)
+                return;
+            Enemy &e = enemies[k];
+            if (!e.active)
+                return;
+
+            if (enemyHit[k].intersects(bulletRect))
             {
-                if (!e.active)
-                    continue;
-                QRect enemyRect;
-                if (e.type == 10)
-                    enemyRect = QRect(e.x + 20, e.y + 20, 160, 110);
-                else if (e.type == 2)
-                    enemyRect = QRect(e.x, e.y, imgEnemy3.width(), imgEnemy3.height());
-                else
-                    enemyRect = QRect(e.x, e.y, imgEnemy1.width(), imgEnemy1.height());
+                // 幻影(ID 3) 穿透
+                if (currentPlaneId != 3)
+                    bullets.kill(i);
+
+                e.hp -= bulletDamage;
 
-                if (enemyRect.intersects(bulletRect))
+                if (e.hp <= 0)
                 {
-                    // 幻影(ID 3) 穿透
-                    if (currentPlaneId != 3)
-                        b.active = false;
-
-                    // 【核心修改】根据 ID 设定伤害
-                    int damage = 1;
-                    switch (currentPlaneId)
-                    {
-                    case 0:
-                        damage = 1;
-                        break; // 勇者
-                    case 1:
-                        damage = 2;
-                        break; // 双子 (2颗x2伤 = 4? 其实双子强在覆盖面)
-                    case 2:
-                        damage = 3;
-                        break; // 泰坦 (3颗x3伤)
-                    case 3:
-                        damage = 4;
-                        break; // 幻影 (面板写4)
-                    case 4:
-                        damage = 5;
-                        break; // 虚空 (面板写5)
-                    }
-                    e.hp -= damage;
-
-                    if (e.hp <= 0)
-                    {
-                        e.active = false;
-                        if (e.type != 10 && progressCounter < totalWaves)
-                            progressCounter++;
-                        int add = (e.type == 10) ? (500 * currentLevel) : (e.type == 2 ? 50 : 10);
-                        if (e.type == 10)
-                            result.bossDied = true;
-                        result.scoreAdded += add;
-                    }
-                    if (currentPlaneId != 3)
-                        break;
+                    e.active = false;
+                    if (e.type != 10 && progressCounter < totalWaves)
+                        progressCounter++;
+                    int add = (e.type == 10) ? (500 * currentLevel) : (e.type == 2 ? 50 : 10);
+                    if (e.type == 10)
+                        result.bossDied = true;
+                    result.scoreAdded += add;
                 }
-            }
-        }
+                if (currentPlaneId != 3)
+                    consumed = true;
+                } });
     }
 
     // --- 3. 身体撞击 ---
-    for (auto &e : enemies)
+    // 敌人数量很少，直接遍历
+    for (int k = 0; k < enemyCount; ++k)
     {
+        Enemy &e = enemies[k];
         if (!e.active)
             continue;
-        QRect enemyRect;
-        if (e.type == 10)
-            enemyRect = QRect(e.x + 40, e.y + 40, 120, 80);
-        else if (e.type == 2)
-            enemyRect = QRect(e.x, e.y, imgEnemy3.width(), imgEnemy3.height());
-        else
-            enemyRect = QRect(e.x, e.y, imgEnemy1.width(), imgEnemy1.height());
-
-        if (heroRect.intersects(enemyRect))
+
+        if (heroRect.intersects(enemyBody[k]))
         {
             if (isShieldActive)
             {
@@ -2,9 +2,10 @@
 #define COLLISIONSYSTEM_H
 
 #include "common.h"
-#include <QList>
-#include <QImage>
-#include <QRect>
+#include "BulletStore.h"
+#include "EnemyPool.h"
+#include "SpatialGrid.h"
+#include "Hitbox.h"
 
 class CollisionSystem
 {
@@ -18,18 +19,35 @@ public:
         int heroDamageTaken;
     };
 
+    // 粗筛网格与碰撞盒缓存 (由调用方长期持有，每帧在 check 内重建，避免反复分配)
+    struct Broadphase
+    {
+        SpatialGrid enemyGrid;   // 敌人 (按"子弹可命中区域"登记)
+        QVector<Aabb> enemyHit;  // 本帧每个敌人的受击框 (下标同 EnemyPool)
+        QVector<Aabb> enemyBody; // 本帧每个敌人的撞击框
+        QVector<int> enemyStamp; // 按矩形查询敌人时的去重标记
+        QVector<int> bulletHits; // 敌方子弹批量判定的命中下标
+        int stamp = 0;
+    };
+
+    static const int CELL_SIZE = 64;     // 网格边长 (逻辑像素)
+    static const int BULLET_SIZE = 8;    // 子弹判定框边长
+    static const int SHIELD_RADIUS = 50; // 护盾半径 (以英雄中心为圆心)
+
     static CollisionResult check(
+        Broadphase &broadphase,
+        double gameWidth, double gameHeight, // 逻辑画面尺寸 (网格覆盖范围)
         double heroX, double heroY, int heroW, int heroH,
-        QList<Bullet> &bullets,
-        QList<Enemy> &enemies,
-        bool isLaserActive,  // 是否激光
-        bool isShieldActive, // 【新增】是否开盾
-        int currentPlaneId,  // 【新增】当前飞机ID (用于判断追踪弹伤害)
+        BulletStore &bullets,
+        EnemyPool &enemies,
+        const HitboxTable &hitboxes, // 各类敌人碰撞盒
+        bool isLaserActive,          // 是否激光
+        bool isShieldActive,         // 【新增】是否开盾
+        int currentPlaneId,          // 【新增】当前飞机ID (幻影子弹穿透)
+        int bulletDamage,            // 每颗玩家子弹伤害 (出击配置快照)
         int currentLevel,
         int totalWaves,
-        int &progressCounter,
-        const QImage &imgEnemy1,
-        const QImage &imgEnemy3);
+        int &progressCounter);
 };
 
-#endif // COLLISIONSYSTEM_H
\ No newline at end of file
+#endif // COLLISIONSYSTEM_H
@@ -1,8 +1,8 @@
 #include "DataManager.h"
+#include "TraceRecorder.h"
 #include <QFile>
 #include <QTextStream>
 #include <QCoreApplication>
-#include <QRandomGenerator>
 
 // 初始化静态成员
 int DataManager::m_coins = 0;
@@ -12,6 +12,7 @@ QList<int> DataManager::m_inventory = {};
 int DataManager::m_equippedCore = -1;
 int DataManager::m_equippedArmor = -1;
 int DataManager::m_equippedEngine = -1;
+LoadoutSnapshot DataManager::m_loadout;
 
 QString DataManager::getFilePath()
 {
@@ -47,10 +48,12 @@ void DataManager::loadData()
         }
         file.close();
     }
+    refreshLoadout();
 }
 
 void DataManager::saveData()
 {
+    TraceScope trace("save", "DataManager::saveData");
     QFile file(getFilePath());
     if (file.open(QIODevice::WriteOnly | QIODevice::Text))
     {
@@ -91,6 +94,7 @@ int DataManager::getCurrentPlaneId() { return m_currentPlaneId; }
 void DataManager::setCurrentPlane(int id)
 {
     m_currentPlaneId = id;
+    refreshLoadout();
     saveData();
 }
 bool DataManager::isPlaneUnlocked(int id)
@@ -228,6 +232,7 @@ void DataManager::equipItem(EquipType type, int equipId)
         m_equippedEngine = equipId;
         break;
     }
+    refreshLoadout();
     saveData();
 }
 
@@ -327,9 +332,9 @@ Equipment DataManager::getEquipmentById(int id)
 }
 
 // 掉落逻辑
-int DataManager::generateDrop(int bossId)
+int DataManager::generateDrop(int bossId, GameRandom &rng)
 {
-    int roll = QRandomGenerator::global()->bounded(100);
+    int roll = rng.bounded(100);
     int tier = TIER_COMMON;
 
     // 概率：普通70%，优良25%，极品5% (随关卡提升概率)
@@ -355,11 +360,16 @@ int DataManager::generateDrop(int bossId)
 
 // 计算最终属性
 PlaneStats DataManager::getFinalStats(int planeId)
+{
+    return getFinalStats(planeId, m_equippedCore, m_equippedArmor, m_equippedEngine);
+}
+
+PlaneStats DataManager::getFinalStats(int planeId, int coreId, int armorId, int engineId)
 {
     PlaneStats base = getPlaneStats(planeId);
 
     // 叠加装备属性
-    QList<int> equips = {m_equippedCore, m_equippedArmor, m_equippedEngine};
+    QList<int> equips = {coreId, armorId, engineId};
     for (int id : equips)
     {
         if (id == -1)
@@ -371,4 +381,55 @@ PlaneStats DataManager::getFinalStats(int planeId)
         base.viewRate *= (1.0 + e.rateBonus); // 射速乘算
     }
     return base;
-}
\ No newline at end of file
+}
+
+const LoadoutSnapshot &DataManager::getLoadout() { return m_loadout; }
+
+// 重算出击配置快照：字符串 / 列表只在这里构造一次，游戏循环里不再调用 getFinalStats
+void DataManager::refreshLoadout()
+{
+    m_loadout = buildLoadout(m_currentPlaneId, m_equippedCore, m_equippedArmor, m_equippedEngine);
+}
+
+LoadoutSnapshot DataManager::buildLoadout(int planeId, int coreId, int armorId, int engineId)
+{
+    PlaneStats stats = getFinalStats(planeId, coreId, armorId, engineId);
+
+    LoadoutSnapshot l;
+    l.planeId = planeId;
+    l.coreId = coreId;
+    l.armorId = armorId;
+    l.engineId = engineId;
+    l.maxHp = stats.hp;
+    l.speed = stats.speed;
+    l.fireRate = stats.viewRate;
+
+    // 射速同步
+    l.shootInterval = (int)(12.0 / stats.viewRate);
+    if (l.shootInterval < 3)
+        l.shootInterval = 3;
+
+    // 【核心修改】根据 ID 设定伤害
+    switch (planeId)
+    {
+    case 0:
+        l.bulletDamage = 1;
+        break; // 勇者
+    case 1:
+        l.bulletDamage = 2;
+        break; // 双子 (2颗x2伤 = 4? 其实双子强在覆盖面)
+    case 2:
+        l.bulletDamage = 3;
+        break; // 泰坦 (3颗x3伤)
+    case 3:
+        l.bulletDamage = 4;
+        break; // 幻影 (面板写4)
+    case 4:
+        l.bulletDamage = 5;
+        break; // 虚空 (面板写5)
+    default:
+        l.bulletDamage = 1;
+        break;
+    }
+    return l;
+}
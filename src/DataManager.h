@@ -2,6 +2,7 @@
 #define DATAMANAGER_H
 
 #include "common.h"
+#include "GameRandom.h"
 #include <QList>
 #include <QMap>
 
@@ -34,10 +35,17 @@ public:
 
     // 装备数据库 & 生成
     static Equipment getEquipmentById(int id);
-    static int generateDrop(int bossId); // 根据BOSS掉落装备ID
+    static int generateDrop(int bossId, GameRandom &rng); // 根据BOSS掉落装备ID (使用对局随机数流)
 
     // 获取最终玩家属性 (战机 + 装备)
     static PlaneStats getFinalStats(int planeId);
+    static PlaneStats getFinalStats(int planeId, int coreId, int armorId, int engineId); // 指定装备 (-1 为空)
+
+    // 当前出击配置快照 (读档 / 换机 / 换装时自动重算)
+    static const LoadoutSnapshot &getLoadout();
+    static void refreshLoadout();
+    // 按指定战机与装备构造快照 (不读写存档，基准测试等离线场景用)
+    static LoadoutSnapshot buildLoadout(int planeId, int coreId = -1, int armorId = -1, int engineId = -1);
 
 private:
     static int m_coins;
@@ -50,6 +58,8 @@ private:
     static int m_equippedArmor;    // 当前装甲ID
     static int m_equippedEngine;   // 当前引擎ID
 
+    static LoadoutSnapshot m_loadout; // 出击配置快照
+
     static QString getFilePath();
 };
 
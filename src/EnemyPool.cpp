@@ -0,0 +1,95 @@
+#include "EnemyPool.h"
+
+EnemyPool::EnemyPool(int capacity)
+    : m_count(0)
+{
+    reserve(capacity);
+}
+
+void EnemyPool::reserve(int capacity)
+{
+    m_items.resize(capacity);
+    m_denseToSlot.resize(capacity);
+    m_slotToDense.resize(capacity);
+    m_generations.resize(capacity);
+    m_freeSlots.reserve(capacity);
+    clear();
+}
+
+void EnemyPool::clear()
+{
+    // 所有槽位放回空闲链表，代数递增让旧句柄全部失效
+    m_count = 0;
+    m_freeSlots.clear();
+    for (int slot = capacity() - 1; slot >= 0; --slot)
+    {
+        if (m_slotToDense[slot] >= 0)
+            m_generations[slot]++;
+        m_slotToDense[slot] = -1;
+        m_freeSlots.append(slot);
+    }
+}
+
+bool EnemyPool::add(const Enemy &e)
+{
+    if (m_freeSlots.isEmpty())
+        return false;
+
+    int slot = m_freeSlots.last();
+    m_freeSlots.removeLast();
+
+    int i = m_count++;
+    m_items[i] = e;
+    m_denseToSlot[i] = slot;
+    m_slotToDense[slot] = i;
+    return true;
+}
+
+EnemyHandle EnemyPool::handleAt(int i) const
+{
+    EnemyHandle h;
+    h.slot = m_denseToSlot[i];
+    h.generation = m_generations[h.slot];
+    return h;
+}
+
+int EnemyPool::indexOf(const EnemyHandle &h) const
+{
+    if (h.slot < 0 || h.slot >= capacity() || m_generations[h.slot] != h.generation)
+        return -1;
+    return m_slotToDense[h.slot];
+}
+
+Enemy *EnemyPool::resolve(const EnemyHandle &h)
+{
+    int i = indexOf(h);
+    return i >= 0 ? &m_items[i] : nullptr;
+}
+
+void EnemyPool::removeInactive()
+{
+    int i = 0;
+    while (i < m_count)
+    {
+        if (m_items[i].active)
+        {
+            ++i;
+            continue;
+        }
+
+        // 回收槽位
+        int slot = m_denseToSlot[i];
+        m_generations[slot]++;
+        m_slotToDense[slot] = -1;
+        m_freeSlots.append(slot);
+
+        // 末尾元素补洞
+        --m_count;
+        if (i != m_count)
+        {
+            m_items[i] = m_items[m_count];
+            m_denseToSlot[i] = m_denseToSlot[m_count];
+            m_slotToDense[m_denseToSlot[i]] = i;
+        }
+    }
+}
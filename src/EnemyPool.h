@@ -0,0 +1,64 @@
+#ifndef ENEMYPOOL_H
+#define ENEMYPOOL_H
+
+#include "common.h"
+#include <QVector>
+
+// 敌人的稳定句柄：swap-and-pop 会移动敌人在数组中的位置，句柄不会失效
+struct EnemyHandle
+{
+    int slot = -1;
+    quint32 generation = 0;
+
+    bool isNull() const { return slot < 0; }
+    bool operator==(const EnemyHandle &o) const { return slot == o.slot && generation == o.generation; }
+    bool operator!=(const EnemyHandle &o) const { return !(*this == o); }
+};
+
+// 敌人池 (固定容量)
+// 敌人紧密排列在 [0, size()) 中便于遍历；另有一张槽位表 + 空闲链表提供稳定句柄。
+// 生成 / 回收都是 O(1)，容量内不发生堆分配。
+class EnemyPool
+{
+public:
+    static const int DEFAULT_CAPACITY = 256;
+
+    explicit EnemyPool(int capacity = DEFAULT_CAPACITY);
+
+    int size() const { return m_count; }
+    int capacity() const { return m_items.size(); }
+    bool isEmpty() const { return m_count == 0; }
+    void clear();
+
+    // 设定容量上限并预分配 (会清空现有敌人)
+    void reserve(int capacity);
+
+    // 加入一个敌人，池满时丢弃并返回 false
+    bool add(const Enemy &e);
+
+    Enemy &operator[](int i) { return m_items[i]; }
+    const Enemy &operator[](int i) const { return m_items[i]; }
+
+    Enemy *begin() { return m_items.data(); }
+    Enemy *end() { return m_items.data() + m_count; }
+    const Enemy *begin() const { return m_items.constData(); }
+    const Enemy *end() const { return m_items.constData() + m_count; }
+
+    // 句柄
+    EnemyHandle handleAt(int i) const;
+    int indexOf(const EnemyHandle &h) const; // 已回收返回 -1
+    Enemy *resolve(const EnemyHandle &h);
+
+    // 移除所有失活敌人 (swap-and-pop，不保持顺序)
+    void removeInactive();
+
+private:
+    QVector<Enemy> m_items;         // 紧密数组
+    QVector<int> m_denseToSlot;     // 数组下标 -> 槽位
+    QVector<int> m_slotToDense;     // 槽位 -> 数组下标 (-1 为空闲)
+    QVector<quint32> m_generations; // 槽位代数，回收时递增使旧句柄失效
+    QVector<int> m_freeSlots;       // 空闲槽位链表 (栈)
+    int m_count;
+};
+
+#endif // ENEMYPOOL_H
@@ -1,4 +1,5 @@
 #include "EquipmentWidget.h"
+#include "ScaledPixmapCache.h"
 #include "DataManager.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -7,7 +8,7 @@
 
 EquipmentWidget::EquipmentWidget(QWidget *parent) : QWidget(parent)
 {
-    bgImg.load("assets/game_bg.png");
+    bgImg = ScaledPixmapCache::image("assets/game_bg.png");
     currentSelectedSlotType = 0;
 
     QHBoxLayout *mainLayout = new QHBoxLayout(this);
@@ -158,7 +159,7 @@ void EquipmentWidget::paintEvent(QPaintEvent *)
 {
     QPainter p(this);
     if (!bgImg.isNull())
-        p.drawImage(rect(), bgImg);
+        p.drawPixmap(0, 0, ScaledPixmapCache::scaled("bg", bgImg, size(), devicePixelRatioF()));
     else
         p.fillRect(rect(), Qt::black);
 }
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "FrameProfiler.h"
+#include <cstring>
+
+FrameProfiler::FrameProfiler()
+    : m_enabled(false),
+      m_lastFrameNs(0),
+      m_currentTicks(0),
+      m_head(0),
+      m_filled(0)
+{
+    std::memset(m_current, 0, sizeof(m_current));
+    std::memset(m_frameNs, 0, sizeof(m_frameNs));
+    std::memset(m_phaseNs, 0, sizeof(m_phaseNs));
+    std::memset(m_ticks, 0, sizeof(m_ticks));
+}
+
+const char *FrameProfiler::phaseName(Phase phase)
+{
+    switch (phase)
+    {
+    case PHASE_SHOOTING:
+        return "shooting";
+    case PHASE_SKILLS:
+        return "skills";
+    case PHASE_SPAWN:
+        return "spawn";
+    case PHASE_ENEMIES:
+        return "enemies";
+    case PHASE_BULLETS:
+        return "bullets";
+    case PHASE_COLLISION:
+        return "collision";
+    case PHASE_CLEANUP:
+        return "cleanup";
+    case PHASE_PAINT_BACKGROUND:
+        return "paint bg";
+    case PHASE_PAINT_ENTITIES:
+        return "paint entities";
+    case PHASE_PAINT_BULLETS:
+        return "paint bullets";
+    case PHASE_PAINT_HUD:
+        return "paint hud";
+    default:
+        return "?";
+    }
+}
+
+void FrameProfiler::setEnabled(bool enabled)
+{
+    if (enabled == m_enabled)
+        return;
+    m_enabled = enabled;
+
+    // 重新开启时清空历史，避免关闭期间的空档被算成一帧
+    m_head = 0;
+    m_filled = 0;
+    m_currentTicks = 0;
+    std::memset(m_current, 0, sizeof(m_current));
+    m_lastFrameNs = nowNs();
+}
+
+void FrameProfiler::endFrame()
+{
+    if (!m_enabled)
+        return;
+
+    const qint64 now = nowNs();
+    m_frameNs[m_head] = now - m_lastFrameNs;
+    m_lastFrameNs = now;
+    std::memcpy(m_phaseNs[m_head], m_current, sizeof(m_current));
+    m_ticks[m_head] = m_currentTicks;
+
+    m_head = (m_head + 1) % HISTORY;
+    if (m_filled < HISTORY)
+        m_filled++;
+
+    std::memset(m_current, 0, sizeof(m_current));
+    m_currentTicks = 0;
+}
+
+double FrameProfiler::frameMs(int index) const
+{
+    return m_frameNs[slot(index)] / 1e6;
+}
+
+double FrameProfiler::averageFrameMs() const
+{
+    if (m_filled == 0)
+        return 0;
+    qint64 sum = 0;
+    for (int i = 0; i < m_filled; ++i)
+        sum += m_frameNs[slot(i)];
+    return sum / 1e6 / m_filled;
+}
+
+double FrameProfiler::maxFrameMs() const
+{
+    qint64 worst = 0;
+    for (int i = 0; i < m_filled; ++i)
+        worst = qMax(worst, m_frameNs[slot(i)]);
+    return worst / 1e6;
+}
+
+double FrameProfiler::averagePhaseMs(Phase phase) const
+{
+    if (m_filled == 0)
+        return 0;
+    qint64 sum = 0;
+    for (int i = 0; i < m_filled; ++i)
+        sum += m_phaseNs[slot(i)][phase];
+    return sum / 1e6 / m_filled;
+}
+
+double FrameProfiler::averageTicksPerFrame() const
+{
+    if (m_filled == 0)
+        return 0;
+    int sum = 0;
+    for (int i = 0; i < m_filled; ++i)
+        sum += m_ticks[slot(i)];
+    return (double)sum / m_filled;
+}
@@ -0,0 +1,131 @@
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include "TraceRecorder.h"
+#include <QtGlobal>
+
+// 逐帧分阶段计时 (性能浮层的数据来源)
+// 逻辑帧各阶段与绘制各阶段用 ScopedPhaseTimer 包住，耗时累加到当前显示帧；
+// 每次 endFrame() 把本帧结果推入环形历史，供浮层画曲线 / 取平均。
+// 关闭时 ScopedPhaseTimer 只做一次判空，不读时钟。只在 GUI 线程使用。
+// 开启事件追踪 (TraceRecorder) 时，同一批计时器顺带把每个阶段记录为 trace 区间事件。
+class FrameProfiler
+{
+public:
+    enum Phase
+    {
+        // 逻辑帧 (GameSimulation::tick)
+        PHASE_SHOOTING,
+        PHASE_SKILLS,
+        PHASE_SPAWN,
+        PHASE_ENEMIES,
+        PHASE_BULLETS,
+        PHASE_COLLISION,
+        PHASE_CLEANUP,
+        // 绘制 (GameWidget::paintEvent)
+        PHASE_PAINT_BACKGROUND,
+        PHASE_PAINT_ENTITIES,
+        PHASE_PAINT_BULLETS,
+        PHASE_PAINT_HUD,
+        PHASE_COUNT
+    };
+
+    static const int HISTORY = 120; // 保留最近 120 个显示帧 (约 2 秒)
+
+    FrameProfiler();
+
+    static const char *phaseName(Phase phase);
+    static bool isPaintPhase(Phase phase) { return phase >= PHASE_PAINT_BACKGROUND; }
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    qint64 nowNs() const { return TraceRecorder::nowNs(); }
+    void addPhase(Phase phase, qint64 ns) { m_current[phase] += ns; }
+    void addTick()
+    {
+        if (m_enabled)
+            m_currentTicks++;
+    }
+
+    // 结束一个显示帧：帧耗时取两次 endFrame() 的间隔
+    void endFrame();
+
+    // --- 历史数据 (下标 0 为最旧的一帧) ---
+    int historySize() const { return m_filled; }
+    double frameMs(int index) const;
+    double averageFrameMs() const;
+    double maxFrameMs() const;
+    double averagePhaseMs(Phase phase) const;
+    double averageTicksPerFrame() const;
+
+private:
+    int slot(int index) const { return (m_head - m_filled + index + HISTORY) % HISTORY; }
+
+    bool m_enabled;
+    qint64 m_lastFrameNs;
+
+    qint64 m_current[PHASE_COUNT]; // 当前帧各阶段累计 (纳秒)
+    int m_currentTicks;            // 当前帧推进的逻辑帧数
+
+    qint64 m_frameNs[HISTORY];
+    qint64 m_phaseNs[HISTORY][PHASE_COUNT];
+    int m_ticks[HISTORY];
+    int m_head;   // 下一帧写入位置
+    int m_filled; // 已写入帧数 (<= HISTORY)
+};
+
+// 作用域计时：构造时记下时间，析构时把耗时累加到对应阶段 (并在追踪开启时记一条 trace 事件)；
+// profiler 与追踪都未开启时什么都不做
+class ScopedPhaseTimer
+{
+public:
+    ScopedPhaseTimer(FrameProfiler *profiler, FrameProfiler::Phase phase)
+        : m_profiler(profiler && profiler->isEnabled() ? profiler : nullptr),
+          m_traced(TraceRecorder::isEnabled()),
+          m_phase(phase),
+          m_startNs(m_profiler || m_traced ? TraceRecorder::nowNs() : 0)
+    {
+    }
+
+    ~ScopedPhaseTimer() { stop(); }
+
+    // 结束当前阶段并立即开始下一阶段 (顺序执行的长函数不必为每段再套一层作用域)
+    void switchTo(FrameProfiler::Phase phase)
+    {
+        if (!m_profiler && !m_traced)
+            return;
+        const qint64 now = TraceRecorder::nowNs();
+        finish(now);
+        m_phase = phase;
+        m_startNs = now;
+    }
+
+    // 提前结束计时 (之后析构不再累加)
+    void stop()
+    {
+        if (m_profiler || m_traced)
+            finish(TraceRecorder::nowNs());
+        m_profiler = nullptr;
+        m_traced = false;
+    }
+
+private:
+    Q_DISABLE_COPY(ScopedPhaseTimer)
+
+    void finish(qint64 now)
+    {
+        if (m_profiler)
+            m_profiler->addPhase(m_phase, now - m_startNs);
+        if (m_traced)
+            TraceRecorder::complete(FrameProfiler::isPaintPhase(m_phase) ? "paint" : "tick",
+                                    FrameProfiler::phaseName(m_phase), m_startNs, now - m_startNs);
+    }
+
+    FrameProfiler *m_profiler;
+    bool m_traced;
+    FrameProfiler::Phase m_phase;
+    qint64 m_startNs;
+};
+
+#endif // FRAMEPROFILER_H
@@ -0,0 +1,81 @@
+#ifndef GAMERANDOM_H
+#define GAMERANDOM_H
+
+#include <QtGlobal>
+
+// 对局随机数流 (xoshiro128**)
+// 每局开始时用一个种子初始化，刷怪 / BOSS AI / 掉落都从这里取数；
+// 同一种子 + 同一输入序列可逐帧复现整局。非线程安全，只在逻辑线程使用。
+// bounded() 的取值区间与 QRandomGenerator 一致：bounded(n) -> [0, n)，bounded(lo, hi) -> [lo, hi)
+class GameRandom
+{
+public:
+    explicit GameRandom(quint64 value = 0) { seed(value); }
+
+    void seed(quint64 value)
+    {
+        m_seed = value;
+        // splitmix64 展开成 128 位状态 (保证状态不全为 0)
+        quint64 z = value;
+        for (int i = 0; i < 2; ++i)
+        {
+            z += 0x9E3779B97F4A7C15ULL;
+            quint64 r = z;
+            r = (r ^ (r >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            r = (r ^ (r >> 27)) * 0x94D049BB133111EBULL;
+            r ^= r >> 31;
+            m_state[i * 2] = (quint32)r;
+            m_state[i * 2 + 1] = (quint32)(r >> 32);
+        }
+    }
+
+    quint64 initialSeed() const { return m_seed; }
+
+    quint32 generate()
+    {
+        const quint32 result = rotl(m_state[1] * 5, 7) * 9;
+        const quint32 t = m_state[1] << 9;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 11);
+        return result;
+    }
+
+    // [0, highest)，highest <= 0 时返回 0
+    int bounded(int highest)
+    {
+        if (highest <= 0)
+            return 0;
+        // Lemire 乘法取区间 (拒绝采样消除偏差)
+        const quint32 range = (quint32)highest;
+        quint64 m = (quint64)generate() * range;
+        quint32 low = (quint32)m;
+        if (low < range)
+        {
+            const quint32 threshold = (0u - range) % range;
+            while (low < threshold)
+            {
+                m = (quint64)generate() * range;
+                low = (quint32)m;
+            }
+        }
+        return (int)(m >> 32);
+    }
+
+    // [lowest, highest)，区间为空时返回 lowest
+    int bounded(int lowest, int highest)
+    {
+        return lowest + bounded(highest - lowest);
+    }
+
+private:
+    static quint32 rotl(quint32 x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    quint32 m_state[4];
+    quint64 m_seed;
+};
+
+#endif // GAMERANDOM_H
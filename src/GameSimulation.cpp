@@ -0,0 +1,577 @@
+#include "GameSimulation.h"
+#include "SimdKernels.h"
+#include "TraceRecorder.h"
+#include <QtMath>
+
+GameSimulation::GameSimulation()
+    : m_gameWidth(960),
+      m_heroSize(60, 60),
+      m_hitboxes(HitboxTable::defaults()),
+      m_profiler(nullptr)
+{
+    LevelConfig config = {1, 0, 1, 0};
+    m_levelConfig = config;
+    m_planeId = PLANE_DEFAULT;
+    m_heroX = 0;
+    m_heroY = 0;
+    m_prevHeroX = 0;
+    m_prevHeroY = 0;
+    m_heroHp = 0;
+    m_score = 0;
+    m_isGameOver = false;
+    m_isVictory = false;
+    m_heroShootTimer = 0;
+    m_progressCounter = 0;
+    m_tickCount = 0;
+    m_bossSpawned = false;
+    m_enemySpawnTimer = 0;
+    m_isUltActive = false;
+    m_ultDurationTimer = 0;
+    m_ultCooldownTimer = ULT_COOLDOWN_MAX;
+    m_isShieldActive = false;
+    m_shieldTimer = 0;
+    m_isTimeFrozen = false;
+    m_freezeTimer = 0;
+    m_nukeFlashOpacity = 0;
+}
+
+void GameSimulation::setHeroSize(const QSize &size)
+{
+    if (!size.isEmpty())
+        m_heroSize = size;
+}
+
+void GameSimulation::setGameWidth(double width)
+{
+    if (width > 0)
+        m_gameWidth = width;
+}
+
+void GameSimulation::setStressConfig(const StressConfig &stress)
+{
+    m_stress = stress;
+    if (m_stress.emissionMultiplier < 1)
+        m_stress.emissionMultiplier = 1;
+}
+
+// ================= 游戏流程控制 =================
+void GameSimulation::start(const LevelConfig &config, const LoadoutSnapshot &loadout, quint64 seed)
+{
+    m_rng.seed(seed);
+    m_levelConfig = config;
+    m_loadout = loadout; // 使用最终数值 (开局时固定，局内不再查询 DataManager)
+    m_planeId = loadout.planeId;
+
+    m_heroX = m_gameWidth / 2 - 30;
+    m_heroY = LOGICAL_HEIGHT - 100;
+    m_prevHeroX = m_heroX;
+    m_prevHeroY = m_heroY;
+    m_score = 0;
+    m_heroHp = m_loadout.maxHp;
+
+    // 重置状态
+    m_isGameOver = false;
+    m_isVictory = false;
+    m_heroShootTimer = 0;
+    m_progressCounter = 0;
+    m_tickCount = 0;
+    m_bossSpawned = false;
+    m_enemySpawnTimer = 0;
+
+    m_isUltActive = false;
+    m_ultDurationTimer = 0;
+    m_ultCooldownTimer = ULT_COOLDOWN_MAX;
+
+    m_isShieldActive = false;
+    m_isTimeFrozen = false;
+    m_nukeFlashOpacity = 0;
+
+    m_bossStrategy.reset();
+    m_bossStrategy.setEmissionMultiplier(m_stress.emissionMultiplier);
+
+    // 对象池只在容量变化时分配，平稳运行的帧内不再有堆分配
+    // (压力模式可把容量调大，但不会低于默认值)
+    int bulletCapacity = BulletStore::DEFAULT_CAPACITY;
+    if (m_stress.bulletCapacity > bulletCapacity)
+        bulletCapacity = m_stress.bulletCapacity;
+    int enemyCapacity = EnemyPool::DEFAULT_CAPACITY;
+    if (m_stress.enemyCapacity > enemyCapacity)
+        enemyCapacity = m_stress.enemyCapacity;
+    m_bullets.reserve(bulletCapacity);
+    m_enemies.reserve(enemyCapacity);
+}
+
+// ================= 游戏更新 =================
+GameEvents GameSimulation::tick(const GameInput &input)
+{
+    GameEvents events;
+    if (m_isGameOver || m_isVictory)
+        return events;
+
+    TraceScope trace("tick", "tick");
+    m_tickCount++;
+
+    applyInput(input);
+    if (input.ultPressed)
+        fireUlt(events);
+
+    if (m_nukeFlashOpacity > 0)
+    {
+        m_nukeFlashOpacity -= 10;
+        if (m_nukeFlashOpacity < 0)
+            m_nukeFlashOpacity = 0;
+    }
+
+    if (m_profiler)
+        m_profiler->addTick();
+
+    // 1. 英雄普攻
+    {
+        ScopedPhaseTimer timer(m_profiler, FrameProfiler::PHASE_SHOOTING);
+        updateHeroShooting(events);
+    }
+
+    // 2. 技能状态
+    {
+        ScopedPhaseTimer timer(m_profiler, FrameProfiler::PHASE_SKILLS);
+        updateSkillTimers();
+    }
+
+    // 3. 刷怪
+    if (!m_isTimeFrozen)
+    {
+        if (!m_bossSpawned)
+        {
+            ScopedPhaseTimer timer(m_profiler, FrameProfiler::PHASE_SPAWN);
+            if (m_progressCounter < m_levelConfig.totalWaves)
+                spawnEnemy();
+            else
+                spawnBoss(events);
+        }
+    }
+
+    // 4. 敌人更新
+    {
+        ScopedPhaseTimer timer(m_profiler, FrameProfiler::PHASE_ENEMIES);
+        updateEnemies();
+    }
+
+    // 5. 子弹更新
+    {
+        ScopedPhaseTimer timer(m_profiler, FrameProfiler::PHASE_BULLETS);
+        updateBullets();
+    }
+
+    {
+        ScopedPhaseTimer timer(m_profiler, FrameProfiler::PHASE_COLLISION);
+        checkCollisions(events);
+    }
+
+    if (m_bossSpawned && m_enemies.isEmpty() && !m_isGameOver && !m_isVictory)
+    {
+        m_isVictory = true;
+        events.victory = true;
+    }
+    {
+        ScopedPhaseTimer timer(m_profiler, FrameProfiler::PHASE_CLEANUP);
+        cleanUp();
+    }
+    return events;
+}
+
+// 输入映射：英雄中心跟随指针，并限制在逻辑画面内
+void GameSimulation::applyInput(const GameInput &input)
+{
+    m_prevHeroX = m_heroX;
+    m_prevHeroY = m_heroY;
+
+    double targetX = input.targetX - m_heroSize.width() / 2;
+    double targetY = input.targetY - m_heroSize.height() / 2;
+    if (targetX < 0)
+        targetX = 0;
+    if (targetX > m_gameWidth - m_heroSize.width())
+        targetX = m_gameWidth - m_heroSize.width();
+    if (targetY < 0)
+        targetY = 0;
+    if (targetY > LOGICAL_HEIGHT - m_heroSize.height())
+        targetY = LOGICAL_HEIGHT - m_heroSize.height();
+    m_heroX = targetX;
+    m_heroY = targetY;
+}
+
+// ================= 大招逻辑 =================
+void GameSimulation::fireUlt(GameEvents &events)
+{
+    if (m_ultCooldownTimer < ULT_COOLDOWN_MAX || m_isUltActive || m_isShieldActive || m_isTimeFrozen)
+        return;
+
+    m_ultCooldownTimer = 0;
+    events.ultFired = m_planeId;
+
+    switch (m_planeId)
+    {
+    case PLANE_DEFAULT:
+        m_isUltActive = true;
+        m_ultDurationTimer = 20;
+        break;
+    case PLANE_DOUBLE:
+        for (int i = 0; i < 36; i++)
+        {
+            double rad = qDegreesToRadians(i * 10.0);
+            m_bullets.add(m_heroX + m_heroSize.width() / 2, m_heroY, qCos(rad) * 12.0, qSin(rad) * 12.0, 0);
+        }
+        break;
+    case PLANE_SHOTGUN:
+        for (int i = 0; i < m_bullets.size(); ++i)
+            if (m_bullets.isEnemy(i))
+                m_bullets.kill(i);
+        for (auto &e : m_enemies)
+        {
+            if (e.active)
+            {
+                e.hp -= 50;
+                if (e.hp <= 0)
+                {
+                    e.active = false;
+                    int add = (e.type == 10) ? (500 * m_levelConfig.levelId) : 100;
+                    m_score += add;
+                    if (e.type == 10)
+                        events.bossDied = true;
+                    if (e.type != 10 && m_progressCounter < m_levelConfig.totalWaves)
+                        m_progressCounter++;
+                }
+            }
+        }
+        m_nukeFlashOpacity = 255;
+        break;
+    case PLANE_SNIPER:
+        m_isShieldActive = true;
+        m_shieldTimer = 300;
+        break;
+    case PLANE_ALIEN:
+        m_isTimeFrozen = true;
+        m_freezeTimer = 300;
+        break;
+    }
+}
+
+void GameSimulation::updateHeroShooting(GameEvents &events)
+{
+    // 射速同步
+    m_heroShootTimer++;
+    if (m_heroShootTimer <= m_loadout.shootInterval)
+        return;
+
+    m_heroShootTimer = 0;
+    double centerX = m_heroX + m_heroSize.width() / 2;
+    if (m_planeId == PLANE_DEFAULT || m_planeId == PLANE_SNIPER || m_planeId == PLANE_ALIEN)
+    {
+        m_bullets.add(centerX - 4, m_heroY, 0, -12.0, 0);
+    }
+    else if (m_planeId == PLANE_DOUBLE)
+    {
+        for (int k : {-10, 10})
+            m_bullets.add(centerX + k, m_heroY, 0, -12.0, 0);
+    }
+    else if (m_planeId == PLANE_SHOTGUN)
+    {
+        for (int k : {-1, 0, 1})
+            m_bullets.add(centerX, m_heroY, k * 3.0, -10.0, 0);
+    }
+    events.shotFired = true;
+}
+
+void GameSimulation::updateSkillTimers()
+{
+    if (m_isUltActive)
+    {
+        m_ultDurationTimer--;
+        if (m_ultDurationTimer <= 0)
+            m_isUltActive = false;
+    }
+    else if (m_isShieldActive)
+    {
+        m_shieldTimer--;
+        if (m_shieldTimer <= 0)
+            m_isShieldActive = false;
+    }
+    else if (m_isTimeFrozen)
+    {
+        m_freezeTimer--;
+        if (m_freezeTimer <= 0)
+            m_isTimeFrozen = false;
+    }
+    else
+    {
+        if (m_ultCooldownTimer < ULT_COOLDOWN_MAX)
+            m_ultCooldownTimer++;
+    }
+}
+
+// 刷怪辅助
+void GameSimulation::spawnEnemy()
+{
+    m_enemySpawnTimer++;
+    int spawnRate = 60 - (m_levelConfig.levelId * 5);
+    if (spawnRate < 20)
+        spawnRate = 20;
+    if (m_stress.spawnInterval > 0)
+        spawnRate = m_stress.spawnInterval - 1; // 压力模式：每 spawnInterval 帧一只，不受下限约束
+
+    if (m_enemySpawnTimer <= spawnRate)
+        return;
+
+    m_enemySpawnTimer = 0;
+    Enemy e;
+    e.x = m_rng.bounded((int)m_gameWidth - 50);
+    e.y = -50;
+    e.active = true;
+    e.shootTimer = 0;
+    e.moveAngle = 0;
+    e.bossId = 0;
+    e.isWarning = false;
+
+    int r = m_rng.bounded(100);
+    if (r < 60)
+    {
+        e.type = 0;
+        e.hp = 1 * m_levelConfig.enemyHpScale;
+        e.maxHp = e.hp;
+    }
+    else if (r < 90)
+    {
+        e.type = 1;
+        e.hp = 2 * m_levelConfig.enemyHpScale;
+        e.maxHp = e.hp;
+    }
+    else
+    {
+        e.type = 2;
+        e.hp = 5 * m_levelConfig.enemyHpScale;
+        e.maxHp = e.hp;
+    }
+
+    m_enemies.add(e);
+}
+
+void GameSimulation::spawnBoss(GameEvents &events)
+{
+    if (m_bossSpawned)
+        return;
+
+    Enemy boss;
+    boss.type = 10;
+    boss.x = m_gameWidth / 2 - 100;
+    boss.y = -150;
+    boss.active = true;
+    boss.maxHp = m_levelConfig.bossHp;
+    boss.hp = boss.maxHp;
+    boss.shootTimer = 0;
+    boss.skillTimer = 0;
+    boss.moveAngle = 0;
+    boss.bossId = m_levelConfig.levelId;
+    boss.isWarning = false;
+    boss.state = STATE_NORMAL;
+
+    // 敌人池满时 (压力测试下可能出现) 本帧不出 BOSS，已停止刷小怪，等小怪离场腾出位置后下一帧重试
+    if (!m_enemies.add(boss))
+        return;
+    m_bossSpawned = true;
+    events.bossSpawned = true;
+}
+
+void GameSimulation::updateEnemies()
+{
+    for (auto &e : m_enemies)
+    {
+        e.prevX = e.x;
+        e.prevY = e.y;
+    }
+    if (m_isTimeFrozen)
+        return;
+
+    for (auto &e : m_enemies)
+    {
+        if (e.type == 10)
+        {
+            const BossState before = e.state;
+            m_bossStrategy.update(e, m_bullets, m_rng, m_heroX, m_heroY, (int)m_gameWidth, LOGICAL_HEIGHT, m_levelConfig);
+            // 状态切换记为 trace 瞬时事件，便于把技能阶段和卡顿帧对上
+            if (e.state != before && TraceRecorder::isEnabled())
+                TraceRecorder::instant("boss", BossStrategy::stateName(e.state), BossStrategy::stateName(before));
+            continue;
+        }
+
+        e.y += 3.0;
+        if (e.type == 1)
+        {
+            e.shootTimer++;
+            if (e.shootTimer > 80)
+            {
+                e.shootTimer = 0;
+                m_bullets.add(e.x + 25, e.y + 50, 0, 7.0, BulletStore::FLAG_ENEMY);
+            }
+        }
+        if (e.y > LOGICAL_HEIGHT)
+            e.active = false;
+    }
+}
+
+void GameSimulation::updateBullets()
+{
+    const int n = m_bullets.size();
+    float *x = m_bullets.x.data();
+    float *y = m_bullets.y.data();
+    float *vx = m_bullets.vx.data();
+    float *vy = m_bullets.vy.data();
+    quint8 *flags = m_bullets.flags.data();
+
+    // 虚空战机：玩家子弹追踪最近的敌人
+    if (m_planeId == PLANE_ALIEN && !m_enemies.isEmpty())
+        updateHoming();
+
+    // 记录上一帧位置 (插值渲染用) + 积分 + 出界剔除，一趟向量化完成
+    // 时停时敌方子弹按掩码冻结 (不移动也不剔除)
+    SimdKernels::integrate(x, y, vx, vy, m_bullets.prevX.data(), m_bullets.prevY.data(), flags, n,
+                           m_isTimeFrozen ? BulletStore::FLAG_ENEMY : 0,
+                           -20, -20, (float)(m_gameWidth + 20), (float)(LOGICAL_HEIGHT + 20));
+}
+
+// 追踪弹：每帧先为所有玩家子弹选定目标，再按单位向量转向
+// BOSS 在场时全体锁定 BOSS；否则在敌人位置网格中由内向外逐圈找最近者 (按平方距离比较，无开方)
+void GameSimulation::updateHoming()
+{
+    const int n = m_bullets.size();
+    const float *x = m_bullets.x.constData();
+    const float *y = m_bullets.y.constData();
+    float *vx = m_bullets.vx.data();
+    float *vy = m_bullets.vy.data();
+    const quint8 *flags = m_bullets.flags.constData();
+
+    EnemyHandle bossHandle;
+    m_homingGrid.reset(m_gameWidth, LOGICAL_HEIGHT, HOMING_CELL_SIZE);
+    const int enemyCount = m_enemies.size();
+    for (int k = 0; k < enemyCount; ++k)
+    {
+        const Enemy &e = m_enemies[k];
+        if (!e.active)
+            continue;
+        if (e.type == 10)
+        {
+            bossHandle = m_enemies.handleAt(k);
+            break;
+        }
+        m_homingGrid.insertPoint(k, e.x, e.y);
+    }
+    m_homingGrid.build();
+
+    // 1. 选目标
+    if (m_homingTargets.size() < m_bullets.capacity())
+        m_homingTargets.resize(m_bullets.capacity());
+    EnemyHandle *targets = m_homingTargets.data();
+    for (int i = 0; i < n; ++i)
+    {
+        if (flags[i] & BulletStore::FLAG_ENEMY)
+            continue;
+        if (!bossHandle.isNull())
+        {
+            targets[i] = bossHandle;
+            continue;
+        }
+        int k = nearestEnemy(x[i], y[i]);
+        targets[i] = (k >= 0) ? m_enemies.handleAt(k) : EnemyHandle();
+    }
+
+    // 2. 转向：速度 = 指向目标中心的单位向量 * 15
+    for (int i = 0; i < n; ++i)
+    {
+        if (flags[i] & BulletStore::FLAG_ENEMY)
+            continue;
+        const Enemy *target = m_enemies.resolve(targets[i]);
+        if (!target)
+            continue;
+        double dx = target->x + 25 - x[i];
+        double dy = target->y + 25 - y[i];
+        double len2 = dx * dx + dy * dy;
+        if (len2 > 0)
+        {
+            double scale = 15.0 / qSqrt(len2);
+            vx[i] = dx * scale;
+            vy[i] = dy * scale;
+        }
+        else
+        {
+            vx[i] = 15.0f;
+            vy[i] = 0;
+        }
+    }
+}
+
+// 返回离 (px, py) 最近的敌人下标 (距离相同取下标小者)，没有敌人时返回 -1
+int GameSimulation::nearestEnemy(float px, float py) const
+{
+    const int cx = m_homingGrid.cellX(px);
+    const int cy = m_homingGrid.cellY(py);
+    const int maxRing = qMax(m_homingGrid.cols(), m_homingGrid.rows());
+    const float cellSize = m_homingGrid.cellSize();
+
+    int best = -1;
+    double bestD2 = 0;
+    for (int ring = 0; ring < maxRing; ++ring)
+    {
+        m_homingGrid.forEachInRing(cx, cy, ring, [&](int k)
+                                   {
+            const Enemy &e = m_enemies[k];
+            double dx = e.x - px;
+            double dy = e.y - py;
+            double d2 = dx * dx + dy * dy;
+            if (best < 0 || d2 < bestD2 || (d2 == bestD2 && k < best))
+            {
+                best = k;
+                bestD2 = d2;
+            } });
+
+        // 更外圈的敌人至少相距 ring * cellSize (减 1 抵消格子换算的浮点误差)
+        double reach = ring * cellSize - 1.0;
+        if (best >= 0 && reach > 0 && bestD2 < reach * reach)
+            break;
+    }
+    return best;
+}
+
+void GameSimulation::checkCollisions(GameEvents &events)
+{
+    auto result = CollisionSystem::check(
+        m_broadphase, m_gameWidth, LOGICAL_HEIGHT,
+        m_heroX, m_heroY, m_heroSize.width(), m_heroSize.height(),
+        m_bullets, m_enemies, m_hitboxes,
+        (m_planeId == PLANE_DEFAULT && m_isUltActive),
+        m_isShieldActive,
+        m_planeId,
+        m_loadout.bulletDamage,
+        m_levelConfig.levelId, m_levelConfig.totalWaves,
+        m_progressCounter);
+
+    m_score += result.scoreAdded;
+    if (result.scoreAdded > 0)
+        events.enemyKilled = true;
+
+    if (result.bossDied)
+        events.bossDied = true;
+
+    if (result.heroHit && !m_isShieldActive)
+    {
+        m_heroHp -= result.heroDamageTaken;
+        if (m_heroHp <= 0 && !m_isGameOver && !m_isVictory)
+        {
+            m_isGameOver = true;
+            events.gameOver = true;
+        }
+    }
+}
+
+void GameSimulation::cleanUp()
+{
+    m_bullets.removeInactive();
+    m_enemies.removeInactive();
+}
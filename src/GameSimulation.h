@@ -0,0 +1,155 @@
+#ifndef GAMESIMULATION_H
+#define GAMESIMULATION_H
+
+#include "common.h"
+#include "BossStrategy.h"
+#include "BulletStore.h"
+#include "EnemyPool.h"
+#include "CollisionSystem.h"
+#include "SpatialGrid.h"
+#include "GameRandom.h"
+#include "FrameProfiler.h"
+#include <QSize>
+
+// 每个逻辑帧的玩家输入 (逻辑坐标)
+struct GameInput
+{
+    double targetX = 0;      // 指针位置 X，英雄中心对准此处 (未做边界限制)
+    double targetY = 0;      // 指针位置 Y
+    bool ultPressed = false; // 本帧是否按下大招
+};
+
+// 一帧内产生的表现层事件 (音效 / 动画 / 结算)，由 GameWidget 消费
+struct GameEvents
+{
+    bool shotFired = false;   // 英雄普攻 -> 射击音效
+    bool enemyKilled = false; // 碰撞得分 -> 爆炸音效
+    int ultFired = -1;        // 释放大招的战机ID (-1 表示未释放)
+    bool bossSpawned = false; // BOSS 登场 -> 切换 BGM / 播放动画
+    bool bossDied = false;    // BOSS 死亡 -> 暂停动画
+    bool gameOver = false;    // 本帧判负
+    bool victory = false;     // 本帧通关
+};
+
+// 无界面的游戏核心：只负责逻辑推进，不依赖 QWidget / 音频 / 图片
+class GameSimulation
+{
+public:
+    static const int LOGICAL_HEIGHT = 600;
+    static const int ULT_COOLDOWN_MAX = 500;
+
+    GameSimulation();
+
+    // 英雄尺寸 (由表现层根据图片实际缩放结果提供，无图时使用默认值)
+    void setHeroSize(const QSize &size);
+
+    void setGameWidth(double width);
+    double gameWidth() const { return m_gameWidth; }
+
+    // 压力测试参数 (跨局保留，下次 start() 生效)
+    void setStressConfig(const StressConfig &stress);
+    const StressConfig &stressConfig() const { return m_stress; }
+
+    // 分阶段计时 (性能浮层)，传 nullptr 关闭；profiler 由调用方持有
+    void setProfiler(FrameProfiler *profiler) { m_profiler = profiler; }
+
+    // 开始新关卡 (seed 决定本局全部随机事件)
+    void start(const LevelConfig &config, const LoadoutSnapshot &loadout, quint64 seed);
+
+    // 推进一个逻辑帧 (固定 1/60 秒，所有速度常量均以"每帧"为单位)
+    GameEvents tick(const GameInput &input);
+
+    // --- 只读状态 (供渲染 / 统计) ---
+    const BulletStore &bullets() const { return m_bullets; }
+    const EnemyPool &enemies() const { return m_enemies; }
+    const LevelConfig &levelConfig() const { return m_levelConfig; }
+    const LoadoutSnapshot &loadout() const { return m_loadout; }
+    quint64 seed() const { return m_rng.initialSeed(); }
+    GameRandom &rng() { return m_rng; } // 结算掉落也从本局随机数流取数
+
+    double heroX() const { return m_heroX; }
+    double heroY() const { return m_heroY; }
+    double prevHeroX() const { return m_prevHeroX; }
+    double prevHeroY() const { return m_prevHeroY; }
+    int heroWidth() const { return m_heroSize.width(); }
+    int heroHeight() const { return m_heroSize.height(); }
+    int heroHp() const { return m_heroHp; }
+    int score() const { return m_score; }
+    int planeId() const { return m_planeId; }
+    int progressCounter() const { return m_progressCounter; }
+    int tickCount() const { return m_tickCount; } // 本局已推进的逻辑帧数 (动画按它计时)
+    bool isBossSpawned() const { return m_bossSpawned; }
+    bool isGameOver() const { return m_isGameOver; }
+    bool isVictory() const { return m_isVictory; }
+    bool isFinished() const { return m_isGameOver || m_isVictory; }
+
+    bool isUltActive() const { return m_isUltActive; }
+    bool isShieldActive() const { return m_isShieldActive; }
+    bool isTimeFrozen() const { return m_isTimeFrozen; }
+    int ultCooldownTimer() const { return m_ultCooldownTimer; }
+    int nukeFlashOpacity() const { return m_nukeFlashOpacity; }
+
+private:
+    static const int HOMING_CELL_SIZE = 128; // 追踪弹目标网格边长
+
+    void applyInput(const GameInput &input);
+    void fireUlt(GameEvents &events);
+    void updateHeroShooting(GameEvents &events);
+    void updateSkillTimers();
+    void spawnEnemy();
+    void spawnBoss(GameEvents &events);
+    void updateEnemies();
+    void updateBullets();
+    void updateHoming();
+    int nearestEnemy(float px, float py) const;
+    void checkCollisions(GameEvents &events);
+    void cleanUp();
+
+    // 尺寸
+    double m_gameWidth;
+    QSize m_heroSize;
+    HitboxTable m_hitboxes; // 敌人碰撞盒表
+    StressConfig m_stress;  // 压力测试参数
+    FrameProfiler *m_profiler;
+
+    // 游戏状态
+    double m_heroX, m_heroY;
+    double m_prevHeroX, m_prevHeroY; // 上一逻辑帧位置 (插值渲染用)
+    int m_heroHp, m_score;
+    bool m_isGameOver;
+    bool m_isVictory;
+    BulletStore m_bullets;
+    EnemyPool m_enemies;
+
+    int m_heroShootTimer;
+    LevelConfig m_levelConfig;
+    LoadoutSnapshot m_loadout; // 本局出击配置
+    GameRandom m_rng;          // 本局随机数流
+    int m_progressCounter;
+    int m_tickCount;
+    bool m_bossSpawned;
+    int m_enemySpawnTimer;
+
+    // 策略模块
+    BossStrategy m_bossStrategy;
+    CollisionSystem::Broadphase m_broadphase; // 碰撞粗筛网格 (跨帧复用)
+    SpatialGrid m_homingGrid;                 // 追踪弹选目标用的敌人位置索引
+    QVector<EnemyHandle> m_homingTargets;     // 每颗子弹本帧锁定的目标
+
+    // --- 战机与技能系统 ---
+    int m_planeId;
+
+    bool m_isUltActive;
+    int m_ultDurationTimer;
+    int m_ultCooldownTimer;
+
+    bool m_isShieldActive;
+    int m_shieldTimer;
+
+    bool m_isTimeFrozen;
+    int m_freezeTimer;
+
+    int m_nukeFlashOpacity;
+};
+
+#endif // GAMESIMULATION_H
@@ -1,10 +1,14 @@
 #include "GameWidget.h"
 #include "ScoreManager.h"
 #include "LevelManager.h"
-#include "CollisionSystem.h"
 #include "DataManager.h"
+#include "TraceRecorder.h"
+#include "ScaledPixmapCache.h"
+#include "AssetManager.h"
+#include "AudioMixer.h"
 #include <QPainter>
 #include <QMouseEvent>
+#include <QKeyEvent>
 #include <QRandomGenerator>
 #include <QDebug>
 #include <QFileInfo>
@@ -22,35 +26,30 @@ GameWidget::GameWidget(QWidget *parent) : QWidget(parent)
     loadAssets();
 
     // --- 音效初始化 ---
-    shootSfx = new QSoundEffect(this);
-    shootSfx->setSource(QUrl::fromLocalFile("assets/shoot.wav"));
-    shootSfx->setVolume(0.3);
+    // 射击最密每 3 帧一次，给足声部让尾音自然叠加；爆炸 / 大招同时响的数量有限
+    sfxMixer = new AudioMixer(this);
+    sfxShoot = sfxMixer->addSound("assets/shoot.wav", 6, 0.3f);
+    sfxExplode = sfxMixer->addSound("assets/explode.wav", 4, 0.6f);
 
-    explodeSfx = new QSoundEffect(this);
-    explodeSfx->setSource(QUrl::fromLocalFile("assets/explode.wav"));
-    explodeSfx->setVolume(0.6);
-
-    // 【核心修复】移除旧的 ultSfx，改为加载列表 ultSfxList
-    ultSfxList.clear();
+    // 大招音效列表
+    sfxUlt.clear();
     for (int i = 0; i < 5; ++i)
     {
-        QSoundEffect *sfx = new QSoundEffect(this);
         // 尝试加载 assets/ult0.wav ~ ult4.wav
         QString path = QString("assets/ult%1.wav").arg(i);
 
         // 兜底逻辑：如果找不到专属音效，就用 laser.wav 或 shoot.wav
-        if (!QFileInfo::exists(path))
+        if (!AssetManager::exists(path))
         {
-            if (QFileInfo::exists("assets/laser.wav"))
+            if (AssetManager::exists("assets/laser.wav"))
                 path = "assets/laser.wav";
             else
                 path = "assets/shoot.wav";
         }
 
-        sfx->setSource(QUrl::fromLocalFile(path));
-        sfx->setVolume(1.0);
-        ultSfxList.append(sfx);
+        sfxUlt.append(sfxMixer->addSound(path, 1, 1.0f));
     }
+    sfxMixer->start();
 
     // --- BGM 初始化 ---
     bgmPlayer = new QMediaPlayer(this);
@@ -58,52 +57,53 @@ GameWidget::GameWidget(QWidget *parent) : QWidget(parent)
     bgmPlayer->setAudioOutput(bgmOutput);
     bgmOutput->setVolume(0.3);
 
-    // --- BOSS 动画初始化 ---
-    bossMovie = new QMovie(this);
-    bossMovie->setCacheMode(QMovie::CacheAll);
-
     // --- 定时器 ---
+    // 定时器只负责驱动主循环，逻辑步数由 frameClock 实际流逝的时间决定
     gameTimer = new QTimer(this);
+    gameTimer->setTimerType(Qt::PreciseTimer);
     connect(gameTimer, &QTimer::timeout, this, &GameWidget::updateGame);
 
-    // --- 变量初始化 ---
-    enemySpawnTimer = 0;
-    isShieldActive = false;
-    isTimeFrozen = false;
-    isUltActive = false;
-    nukeFlashOpacity = 0;
+    lastFrameNs = 0;
+    tickAccumulator = 0;
+    renderAlpha = 0;
+
+    sim.setProfiler(&profiler);
+    setFocusPolicy(Qt::StrongFocus); // 接收 F3 (性能浮层开关)
 }
 
 // ================= 资源加载 =================
 void GameWidget::loadAssets()
 {
-    imgHero.load("assets/hero.png");
-    imgEnemy1.load("assets/enemy.png");
-    imgEnemy2.load("assets/enemy2.png");
-    imgEnemy3.load("assets/enemy3.png");
-    imgBg.load("assets/game_bg.png");
-
-    if (!imgHero.isNull())
-        imgHero = imgHero.scaled(60, 60, Qt::KeepAspectRatio);
-    if (!imgEnemy1.isNull())
-        imgEnemy1 = imgEnemy1.scaled(50, 50, Qt::KeepAspectRatio);
-    if (!imgEnemy2.isNull())
-        imgEnemy2 = imgEnemy2.scaled(50, 50, Qt::KeepAspectRatio);
-    if (!imgEnemy3.isNull())
-        imgEnemy3 = imgEnemy3.scaled(120, 120, Qt::KeepAspectRatio);
-
-    // 加载5种子弹图片
-    bulletImages.clear();
+    TraceScope trace("asset", "loadAssets");
+    // 启动时已由 AssetManager 在线程池里解码 / 缩小，这里只取结果
+    imgHero = AssetManager::image("assets/hero.png", QSize(60, 60));
+    imgEnemy1 = AssetManager::image("assets/enemy.png", QSize(50, 50));
+    imgEnemy2 = AssetManager::image("assets/enemy2.png", QSize(50, 50));
+    imgEnemy3 = AssetManager::image("assets/enemy3.png", QSize(120, 120));
+    imgBg = ScaledPixmapCache::image("assets/game_bg.png");
+
+    // 5种子弹图片 (源图交给精灵缓存，按实际显示分辨率缩放)
     for (int i = 0; i < 5; ++i)
-    {
-        QString path = QString("assets/bullet%1.png").arg(i);
-        QImage img;
-        if (img.load(path))
-        {
-            img = img.scaled(20, 40, Qt::KeepAspectRatio);
-        }
-        bulletImages.append(img);
-    }
+        bulletSprites.setPlayerImage(i, AssetManager::image(QString("assets/bullet%1.png").arg(i), AssetManager::bulletBox()));
+    atlasDirty = true;
+}
+
+// 图集按当前显示分辨率生成；缩放变化 (窗口缩放 / 换屏) 或贴图变化时整体重建
+void GameWidget::ensureAtlas(qreal deviceScale)
+{
+    if (!atlasDirty && qFuzzyCompare(deviceScale, atlasScale))
+        return;
+    TraceScope trace("asset", "buildAtlas");
+    atlasDirty = false;
+    atlasScale = deviceScale;
+
+    atlas.clear();
+    spriteHero = atlas.add(imgHero, imgHero.size(), deviceScale);
+    spriteEnemy[0] = atlas.add(imgEnemy1, imgEnemy1.size(), deviceScale);
+    spriteEnemy[1] = atlas.add(imgEnemy2, imgEnemy2.size(), deviceScale);
+    spriteEnemy[2] = atlas.add(imgEnemy3, imgEnemy3.size(), deviceScale);
+    bulletSprites.addToAtlas(atlas, deviceScale);
+    atlas.build();
 }
 
 // ================= 分辨率适配辅助 =================
@@ -130,468 +130,204 @@ QPointF GameWidget::mapToGame(const QPoint &pos)
     return QPointF(pos.x() / scale, pos.y() / scale);
 }
 
+void GameWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    // 回放时画面宽度取自录像
+    if (!replaying)
+        sim.setGameWidth(getGameWidth());
+}
+
 // ================= 游戏流程控制 =================
 void GameWidget::startGame(int level)
 {
-    setCursor(Qt::BlankCursor);
-    currentLevelConfig = LevelManager::getLevelConfig(level);
+    LevelConfig config = LevelManager::getLevelConfig(level);
 
-    // 加载战机
-    currentPlaneId = DataManager::getCurrentPlaneId();
-    PlaneStats stats = DataManager::getFinalStats(currentPlaneId); // 使用最终数值
+    // 出击配置快照：本局只算这一次
+    DataManager::refreshLoadout();
+    const LoadoutSnapshot &loadout = DataManager::getLoadout();
 
-    heroX = getGameWidth() / 2 - 30;
-    heroY = LOGICAL_HEIGHT - 100;
-    score = 0;
-    heroHp = stats.hp;
+    prepareRun(level, loadout.planeId);
 
-    QString heroPath;
-    if (currentPlaneId == 0)
-        heroPath = "assets/hero.png";
-    else
-        heroPath = QString("assets/plane%1.png").arg(currentPlaneId);
+    // 重置逻辑核心
+    sim.setHeroSize(imgHero.size());
+    sim.setGameWidth(getGameWidth());
+    sim.setStressConfig(stress);
+    // 每局一个新种子；之后的刷怪 / BOSS 行为 / 掉落全部由它决定
+    sim.start(config, loadout, QRandomGenerator::global()->generate64());
 
-    if (!imgHero.load(heroPath))
-        imgHero.load("assets/hero.png");
+    // 本局输入录像
+    replaying = false;
+    recording.begin(sim.seed(), config, loadout, sim.stressConfig(), QSize(sim.heroWidth(), sim.heroHeight()), sim.gameWidth());
 
-    if (currentPlaneId == 2)
-        imgHero = imgHero.scaled(80, 80, Qt::KeepAspectRatio);
-    else
-        imgHero = imgHero.scaled(60, 60, Qt::KeepAspectRatio);
+    beginLoop();
+}
 
-    // 加载 BOSS 头像
-    QString bossIconPath = QString("assets/boss%1.png").arg(level);
-    if (!QFileInfo::exists(bossIconPath))
-        bossIconPath = QString("assets/boss%1.gif").arg(level);
-    if (!currentBossIcon.load(bossIconPath))
-        currentBossIcon = imgEnemy3;
-    currentBossIcon = currentBossIcon.scaled(60, 60, Qt::KeepAspectRatio);
+// 回放录像：关卡 / 配置 / 种子全部取自录像，输入逐帧取自录像而非鼠标
+void GameWidget::startReplay(const Replay &replay)
+{
+    playback = replay;
+    replaying = true;
+    replayTick = 0;
 
-    // 重置状态
-    isGameOver = false;
-    isVictory = false;
-    heroShootTimer = 0;
-    progressCounter = 0;
-    bossSpawned = false;
-    enemySpawnTimer = 0;
+    prepareRun(replay.levelConfig().levelId, replay.loadout().planeId);
+    replay.startSimulation(sim);
 
-    isUltActive = false;
-    ultDurationTimer = 0;
-    ULT_COOLDOWN_MAX = 500;
-    ultCooldownTimer = ULT_COOLDOWN_MAX;
+    beginLoop();
+}
 
-    isShieldActive = false;
-    isTimeFrozen = false;
-    nukeFlashOpacity = 0;
+// 加载本局战机与 BOSS 头像
+void GameWidget::prepareRun(int level, int planeId)
+{
+    TraceScope trace("asset", "prepareRun");
+    setCursor(Qt::BlankCursor);
+
+    // 战机 (共享的已缩小副本，不再每局从磁盘重新解码)
+    imgHero = AssetManager::image(AssetManager::planePath(planeId), AssetManager::planeBox(planeId));
+    if (imgHero.isNull())
+        imgHero = AssetManager::image("assets/hero.png", AssetManager::planeBox(planeId));
+
+    // BOSS 头像
+    currentBossIcon = AssetManager::image(AssetManager::bossIconPath(level), QSize(60, 60));
+    if (currentBossIcon.isNull())
+        currentBossIcon = imgEnemy3.scaled(60, 60, Qt::KeepAspectRatio);
 
-    bossStrategy.reset();
+    atlasDirty = true; // 战机换了
+
+    // BOSS 动画：趁关卡加载在后台解码，按当前显示尺寸预先缩放
+    QString bossGifPath = QString("assets/boss%1.gif").arg(level);
+    if (QFileInfo::exists(bossGifPath))
+        bossAnimation.load(bossGifPath, QSize(BOSS_ANIM_WIDTH, BOSS_ANIM_HEIGHT), getGameScale() * devicePixelRatioF());
+    else
+        bossAnimation.clear();
+}
 
-    bullets.clear();
-    enemies.clear();
+// 逻辑核心就绪后：重置输入 / 动画 / 音乐并启动主循环
+void GameWidget::beginLoop()
+{
+    pendingInput = GameInput();
+    pendingInput.targetX = sim.heroX() + sim.heroWidth() / 2;
+    pendingInput.targetY = sim.heroY() + sim.heroHeight() / 2;
 
-    if (bossMovie->isValid())
-        bossMovie->stop();
+    bossSpawnTick = 0;
 
     QString bgmPath = "assets/game_bgm.mp3";
     bgmPlayer->setSource(QUrl::fromLocalFile(bgmPath));
     bgmPlayer->setLoops(QMediaPlayer::Infinite);
     bgmPlayer->play();
 
-    gameTimer->start(16);
+    tickAccumulator = 0;
+    renderAlpha = 0;
+    frameClock.start();
+    lastFrameNs = 0;
+    gameTimer->start(4);
 }
 
 void GameWidget::stopGame()
 {
     gameTimer->stop();
     bgmPlayer->stop();
-    if (bossMovie->isValid())
-        bossMovie->setPaused(true);
     setCursor(Qt::ArrowCursor);
 }
 
-// ================= 大招逻辑 =================
-void GameWidget::fireUlt()
-{
-    if (isGameOver || isVictory)
-        return;
-
-    if (ultCooldownTimer >= ULT_COOLDOWN_MAX && !isUltActive && !isShieldActive && !isTimeFrozen)
-    {
-        ultCooldownTimer = 0;
-
-        // 【核心修复】播放对应音效
-        if (currentPlaneId >= 0 && currentPlaneId < ultSfxList.size())
-        {
-            ultSfxList[currentPlaneId]->play();
-        }
-
-        switch (currentPlaneId)
-        {
-        case PLANE_DEFAULT:
-            isUltActive = true;
-            ultDurationTimer = 20;
-            break;
-        case PLANE_DOUBLE:
-            for (int i = 0; i < 36; i++)
-            {
-                Bullet b;
-                b.x = heroX + imgHero.width() / 2;
-                b.y = heroY;
-                b.isEnemy = false;
-                b.active = true;
-                double rad = qDegreesToRadians(i * 10.0);
-                b.speedX = qCos(rad) * 12.0;
-                b.speedY = qSin(rad) * 12.0;
-                bullets.append(b);
-            }
-            break;
-        case PLANE_SHOTGUN:
-            for (auto &b : bullets)
-                if (b.isEnemy)
-                    b.active = false;
-            for (auto &e : enemies)
-            {
-                if (e.active)
-                {
-                    e.hp -= 50;
-                    if (e.hp <= 0)
-                    {
-                        e.active = false;
-                        int add = (e.type == 10) ? (500 * currentLevelConfig.levelId) : 100;
-                        score += add;
-                        if (e.type == 10 && bossMovie->isValid())
-                            bossMovie->setPaused(true);
-                        if (e.type != 10 && progressCounter < currentLevelConfig.totalWaves)
-                            progressCounter++;
-                    }
-                }
-            }
-            nukeFlashOpacity = 255;
-            // explodeSfx->play(); // 音效已在上面统一播放
-            break;
-        case PLANE_SNIPER:
-            isShieldActive = true;
-            shieldTimer = 300;
-            break;
-        case PLANE_ALIEN:
-            isTimeFrozen = true;
-            freezeTimer = 300;
-            break;
-        }
-    }
-}
-
 // ================= 游戏更新 =================
 void GameWidget::updateGame()
 {
-    if (isGameOver || isVictory)
+    if (sim.isFinished())
         return;
 
-    if (nukeFlashOpacity > 0)
-    {
-        nukeFlashOpacity -= 10;
-        if (nukeFlashOpacity < 0)
-            nukeFlashOpacity = 0;
-    }
+    qint64 nowNs = frameClock.nsecsElapsed();
+    tickAccumulator += (nowNs - lastFrameNs) / 1000000.0;
+    lastFrameNs = nowNs;
 
-    // 1. 英雄普攻 (射速同步)
-    heroShootTimer++;
-    PlaneStats stats = DataManager::getFinalStats(currentPlaneId);
-    int shootInterval = (int)(12.0 / stats.viewRate);
-    if (shootInterval < 3)
-        shootInterval = 3;
-
-    if (heroShootTimer > shootInterval)
+    // 按固定步长补齐积压的时间，卡顿后以确定的帧数追上
+    int steps = 0;
+    while (tickAccumulator >= TICK_MS && steps < MAX_CATCHUP_TICKS)
     {
-        heroShootTimer = 0;
-        if (currentPlaneId == PLANE_DEFAULT || currentPlaneId == PLANE_SNIPER || currentPlaneId == PLANE_ALIEN)
-        {
-            Bullet b;
-            b.x = heroX + imgHero.width() / 2 - 4;
-            b.y = heroY;
-            b.speedX = 0;
-            b.speedY = -12.0;
-            b.isEnemy = false;
-            b.active = true;
-            bullets.append(b);
-        }
-        else if (currentPlaneId == PLANE_DOUBLE)
+        GameInput input;
+        if (replaying)
         {
-            for (int k : {-10, 10})
-            {
-                Bullet b;
-                b.x = heroX + imgHero.width() / 2 + k;
-                b.y = heroY;
-                b.speedX = 0;
-                b.speedY = -12.0;
-                b.isEnemy = false;
-                b.active = true;
-                bullets.append(b);
-            }
-        }
-        else if (currentPlaneId == PLANE_SHOTGUN)
-        {
-            for (int k : {-1, 0, 1})
-            {
-                Bullet b;
-                b.x = heroX + imgHero.width() / 2;
-                b.y = heroY;
-                b.speedX = k * 3.0;
-                b.speedY = -10.0;
-                b.isEnemy = false;
-                b.active = true;
-                bullets.append(b);
-            }
-        }
-        shootSfx->play();
-    }
-
-    // 2. 技能状态
-    if (isUltActive)
-    {
-        ultDurationTimer--;
-        if (ultDurationTimer <= 0)
-            isUltActive = false;
-    }
-    else if (isShieldActive)
-    {
-        shieldTimer--;
-        if (shieldTimer <= 0)
-            isShieldActive = false;
-    }
-    else if (isTimeFrozen)
-    {
-        freezeTimer--;
-        if (freezeTimer <= 0)
-            isTimeFrozen = false;
-    }
-    else
-    {
-        if (ultCooldownTimer < ULT_COOLDOWN_MAX)
-            ultCooldownTimer++;
-    }
-
-    // 3. 刷怪
-    if (!isTimeFrozen)
-    {
-        if (!bossSpawned)
-        {
-            if (progressCounter < currentLevelConfig.totalWaves)
-                spawnEnemy();
-            else
-                spawnBoss();
-        }
-    }
-
-    // 4. 敌人更新
-    for (auto &e : enemies)
-    {
-        if (isTimeFrozen)
-            continue;
-
-        if (e.type == 10)
-        {
-            bossStrategy.update(e, bullets, heroX, heroY, (int)getGameWidth(), LOGICAL_HEIGHT, currentLevelConfig);
+            if (replayTick >= playback.tickCount())
+                break; // 录像已放完
+            input = playback.applyTick(replayTick++, sim);
         }
         else
         {
-            e.y += 3.0;
-            if (e.type == 1)
-            {
-                e.shootTimer++;
-                if (e.shootTimer > 80)
-                {
-                    e.shootTimer = 0;
-                    Bullet b;
-                    b.x = e.x + 25;
-                    b.y = e.y + 50;
-                    b.speedX = 0;
-                    b.speedY = 7.0;
-                    b.isEnemy = true;
-                    b.active = true;
-                    bullets.append(b);
-                }
-            }
-            if (e.y > LOGICAL_HEIGHT)
-                e.active = false;
+            // 先量化再交给逻辑核心，保证录像回放与本局逐帧一致
+            input = Replay::quantize(pendingInput);
+            recording.recordTick(input, sim.gameWidth());
         }
-    }
 
-    // 5. 子弹更新
-    for (auto &b : bullets)
-    {
-        if (isTimeFrozen && b.isEnemy)
-            continue;
+        GameEvents events = sim.tick(input);
+        pendingInput.ultPressed = false;
+        tickAccumulator -= TICK_MS;
+        steps++;
 
-        if (!b.isEnemy && currentPlaneId == PLANE_ALIEN && !enemies.isEmpty())
-        {
-            Enemy *closest = nullptr;
-            double minDist = 100000;
-            for (auto &e : enemies)
-            {
-                if (!e.active)
-                    continue;
-                if (e.type == 10)
-                {
-                    closest = &e;
-                    break;
-                }
-                double d = qSqrt(qPow(e.x - b.x, 2) + qPow(e.y - b.y, 2));
-                if (d < minDist)
-                {
-                    minDist = d;
-                    closest = &e;
-                }
-            }
-            if (closest)
-            {
-                double targetX = closest->x + 25;
-                double targetY = closest->y + 25;
-                double dx = targetX - b.x;
-                double dy = targetY - b.y;
-                double angle = qAtan2(dy, dx);
-                b.speedX = qCos(angle) * 15.0;
-                b.speedY = qSin(angle) * 15.0;
-            }
-        }
-
-        b.x += b.speedX;
-        b.y += b.speedY;
-        if (b.y < -20 || b.y > LOGICAL_HEIGHT + 20 || b.x < -20 || b.x > getGameWidth() + 20)
-            b.active = false;
+        handleEvents(events);
+        if (sim.isFinished())
+            break;
     }
+    if (tickAccumulator >= TICK_MS)
+        tickAccumulator = 0; // 长时间卡顿 (拖动窗口 / 弹窗)：放弃追帧，避免死亡螺旋
 
-    checkCollisions();
-
-    if (bossSpawned && enemies.isEmpty())
-        victory();
-    cleanUp();
+    renderAlpha = sim.isFinished() ? 1.0 : tickAccumulator / TICK_MS;
     update();
 }
 
-void GameWidget::checkCollisions()
+// 把逻辑核心产生的事件转成音效 / 动画 / 结算
+void GameWidget::handleEvents(const GameEvents &events)
 {
-    auto result = CollisionSystem::check(
-        heroX, heroY, imgHero.width(), imgHero.height(),
-        bullets, enemies,
-        (currentPlaneId == PLANE_DEFAULT && isUltActive),
-        isShieldActive,
-        currentPlaneId,
-        currentLevelConfig.levelId, currentLevelConfig.totalWaves,
-        progressCounter, imgEnemy1, imgEnemy3);
-
-    score += result.scoreAdded;
-    if (result.scoreAdded > 0)
-        explodeSfx->play();
-
-    if (result.bossDied)
-    {
-        if (bossMovie->isValid())
-            bossMovie->setPaused(true);
-    }
-
-    if (result.heroHit)
-    {
-        if (!isShieldActive)
-        {
-            heroHp -= result.heroDamageTaken;
-            if (heroHp <= 0)
-                gameOver();
-        }
-    }
-}
-
-// 刷怪辅助
-void GameWidget::spawnEnemy()
-{
-    enemySpawnTimer++;
-    int spawnRate = 60 - (currentLevelConfig.levelId * 5);
-    if (spawnRate < 20)
-        spawnRate = 20;
-
-    if (enemySpawnTimer > spawnRate)
-    {
-        enemySpawnTimer = 0;
-        Enemy e;
-        e.x = QRandomGenerator::global()->bounded((int)getGameWidth() - 50);
-        e.y = -50;
-        e.active = true;
-        e.shootTimer = 0;
-        e.moveAngle = 0;
-        e.bossId = 0;
-        e.isWarning = false;
-
-        int r = QRandomGenerator::global()->bounded(100);
-        if (r < 60)
-        {
-            e.type = 0;
-            e.hp = 1 * currentLevelConfig.enemyHpScale;
-            e.maxHp = e.hp;
-        }
-        else if (r < 90)
-        {
-            e.type = 1;
-            e.hp = 2 * currentLevelConfig.enemyHpScale;
-            e.maxHp = e.hp;
-        }
-        else
-        {
-            e.type = 2;
-            e.hp = 5 * currentLevelConfig.enemyHpScale;
-            e.maxHp = e.hp;
-        }
-
-        enemies.append(e);
-    }
+    if (events.ultFired >= 0 && events.ultFired < sfxUlt.size())
+        sfxMixer->play(sfxUlt[events.ultFired]);
+    if (events.shotFired)
+        sfxMixer->play(sfxShoot);
+    if (events.enemyKilled)
+        sfxMixer->play(sfxExplode);
+    if (events.bossSpawned)
+        onBossSpawned();
+    if (events.gameOver)
+        gameOver();
+    else if (events.victory)
+        victory();
 }
 
-void GameWidget::spawnBoss()
+void GameWidget::onBossSpawned()
 {
-    if (bossSpawned)
-        return;
-    bossSpawned = true;
-
-    QString bossBgmPath = QString("assets/boss%1_bgm.mp3").arg(currentLevelConfig.levelId);
+    int levelId = sim.levelConfig().levelId;
+    QString bossBgmPath = QString("assets/boss%1_bgm.mp3").arg(levelId);
     if (!QFileInfo::exists(bossBgmPath))
         bossBgmPath = "assets/game_bgm.mp3";
     bgmPlayer->stop();
     bgmPlayer->setSource(QUrl::fromLocalFile(bossBgmPath));
     bgmPlayer->play();
 
-    QString bossGifPath = QString("assets/boss%1.gif").arg(currentLevelConfig.levelId);
-    if (QFileInfo::exists(bossGifPath))
-    {
-        bossMovie->setFileName(bossGifPath);
-        bossMovie->start();
-    }
-    else
-    {
-        bossMovie->setFileName("");
-    }
-
-    Enemy boss;
-    boss.type = 10;
-    boss.x = getGameWidth() / 2 - 100;
-    boss.y = -150;
-    boss.active = true;
-    boss.maxHp = currentLevelConfig.bossHp;
-    boss.hp = boss.maxHp;
-    boss.shootTimer = 0;
-    boss.moveAngle = 0;
-    boss.bossId = currentLevelConfig.levelId;
-    boss.isWarning = false;
-    boss.state = STATE_NORMAL;
-    enemies.append(boss);
+    // 动画从登场这一逻辑帧开始计时 (帧已在 prepareRun 时后台解码好)
+    bossSpawnTick = sim.tickCount();
 }
 
 // ================= 绘制 =================
 void GameWidget::paintEvent(QPaintEvent *event)
 {
     QPainter p(this);
-
-    // 1. 全屏背景
+    TraceScope trace("paint", "paint");
+
+    // 渲染位置 = 上一逻辑帧与当前逻辑帧之间按 renderAlpha 插值
+    auto lerp = [this](double prev, double curr)
+    { return prev + (curr - prev) * renderAlpha; };
+    const double heroX = lerp(sim.prevHeroX(), sim.heroX());
+    const double heroY = lerp(sim.prevHeroY(), sim.heroY());
+    const int currentPlaneId = sim.planeId();
+    const bool isUltActive = sim.isUltActive();
+    const bool isShieldActive = sim.isShieldActive();
+    const bool isTimeFrozen = sim.isTimeFrozen();
+    const int nukeFlashOpacity = sim.nukeFlashOpacity();
+    const LevelConfig &currentLevelConfig = sim.levelConfig();
+
+    ScopedPhaseTimer paintTimer(&profiler, FrameProfiler::PHASE_PAINT_BACKGROUND);
+
+    // 1. 全屏背景 (缓存的缩放结果，只在窗口尺寸变化时重新缩放)
     if (!imgBg.isNull())
-        p.drawImage(rect(), imgBg);
+        p.drawPixmap(0, 0, ScaledPixmapCache::scaled("bg", imgBg, size(), devicePixelRatioF()));
     else
         p.fillRect(rect(), Qt::black);
 
@@ -607,6 +343,10 @@ void GameWidget::paintEvent(QPaintEvent *event)
     if (isTimeFrozen)
         p.fillRect(QRect(0, 0, (int)gameW, LOGICAL_HEIGHT), QColor(0, 0, 255, 50));
 
+    paintTimer.switchTo(FrameProfiler::PHASE_PAINT_ENTITIES);
+
+    ensureAtlas(scale * devicePixelRatioF());
+
     if (currentPlaneId == PLANE_DEFAULT && isUltActive)
     {
         QLinearGradient gradient(heroX + imgHero.width() / 2 - 40, 0, heroX + imgHero.width() / 2 + 40, 0);
@@ -618,19 +358,24 @@ void GameWidget::paintEvent(QPaintEvent *event)
         p.drawRect(heroX + imgHero.width() / 2 - 40, 0, 80, heroY);
     }
 
-    p.drawImage(heroX, heroY, imgHero);
+    atlas.draw(p, spriteHero, heroX, heroY);
 
     if (isShieldActive)
     {
         p.setPen(QPen(Qt::cyan, 3));
         p.setBrush(QColor(0, 255, 255, 50));
-        p.drawEllipse(QPointF(heroX + imgHero.width() / 2, heroY + imgHero.height() / 2), 50, 50);
+        p.drawEllipse(QPointF(heroX + imgHero.width() / 2, heroY + imgHero.height() / 2), CollisionSystem::SHIELD_RADIUS, CollisionSystem::SHIELD_RADIUS);
     }
 
-    for (const auto &e : enemies)
+    for (const auto &e : sim.enemies())
     {
+        const double ex = lerp(e.prevX, e.x);
+        const double ey = lerp(e.prevY, e.y);
         if (e.type == 10)
         {
+            // 先提交已攒下的小怪，保持原来的绘制先后顺序
+            entityBatch.flush(p, atlas);
+
             // 预警绘制
             if (e.state == STATE_WARNING || e.isWarning)
             {
@@ -646,137 +391,72 @@ void GameWidget::paintEvent(QPaintEvent *event)
                 {
                     p.save();
                     p.setPen(QPen(QColor(255, 0, 0, 150), 2, Qt::DotLine));
-                    p.drawLine(QPointF(e.x + 100, e.y + 100), QPointF(e.attackTargetX, e.attackTargetY));
+                    p.drawLine(QPointF(ex + 100, ey + 100), QPointF(e.attackTargetX, e.attackTargetY));
                     p.setPen(QPen(Qt::red, 3));
                     p.setBrush(Qt::NoBrush);
                     p.drawEllipse(QPointF(e.attackTargetX, e.attackTargetY), 30, 30);
                     if (e.state == STATE_SKILL_DASH)
                     {
                         p.setOpacity(0.5);
-                        p.drawImage(e.x - e.dashSpeedX * 2, e.y - e.dashSpeedY * 2, imgEnemy3);
+                        atlas.draw(p, spriteEnemy[2], ex - e.dashSpeedX * 2, ey - e.dashSpeedY * 2);
                     }
                     p.restore();
                 }
             }
 
-            if (bossMovie->isValid() && (bossMovie->state() == QMovie::Running || bossMovie->state() == QMovie::Paused))
+            // 动画随逻辑帧推进，结算 / 暂停时停在当前帧
+            const QPixmap *bossFrame = bossAnimation.frameAt((sim.tickCount() - bossSpawnTick) * TICK_MS);
+            if (bossFrame)
             {
-                p.drawPixmap(QRect(e.x, e.y, 200, 150), bossMovie->currentPixmap());
+                p.drawPixmap(QRectF(ex, ey, BOSS_ANIM_WIDTH, BOSS_ANIM_HEIGHT), *bossFrame, QRectF(bossFrame->rect()));
             }
             else
             {
-                p.drawImage(e.x, e.y, imgEnemy3);
+                atlas.draw(p, spriteEnemy[2], ex, ey);
             }
             p.setBrush(Qt::red);
-            p.drawRect(e.x, e.y - 15, 200, 8);
+            p.drawRect(ex, ey - 15, 200, 8);
             p.setBrush(Qt::green);
             float hpPer = (float)e.hp / (float)e.maxHp;
-            p.drawRect(e.x, e.y - 15, 200 * hpPer, 8);
+            p.drawRect(ex, ey - 15, 200 * hpPer, 8);
         }
         else
         {
-            QImage *currentImg = &imgEnemy1;
+            int sprite = spriteEnemy[0];
             if (e.type == 1)
-                currentImg = &imgEnemy2;
+                sprite = spriteEnemy[1];
             if (e.type == 2)
-                currentImg = &imgEnemy3;
-            p.drawImage(e.x, e.y, *currentImg);
+                sprite = spriteEnemy[2];
+            entityBatch.add(atlas, sprite, ex, ey);
         }
     }
+    entityBatch.flush(p, atlas);
 
-    p.setPen(Qt::NoPen);
-    for (const auto &b : bullets)
+    paintTimer.switchTo(FrameProfiler::PHASE_PAINT_BULLETS);
+
+    // 子弹：图集精灵攒成一批，每页一次 drawPixmapFragments
+    const int enemyNormal = bulletSprites.spriteId(BulletSprites::ENEMY_NORMAL);
+    const int enemySpecial = bulletSprites.spriteId(BulletSprites::ENEMY_SPECIAL);
+    const int playerBullet = bulletSprites.spriteId(BulletSprites::playerKind(currentPlaneId));
+    const BulletStore &bullets = sim.bullets();
+    for (int i = 0; i < bullets.size(); ++i)
     {
-        if (!b.active)
+        if (!bullets.isActive(i))
             continue;
+        const double bx = lerp(bullets.prevX[i], bullets.x[i]);
+        const double by = lerp(bullets.prevY[i], bullets.y[i]);
 
-        if (b.isEnemy)
-        {
-            if (b.isSpecial)
-            {
-                QRadialGradient gradient(b.x + 10, b.y + 10, 15);
-                gradient.setColorAt(0.0, Qt::white);
-                gradient.setColorAt(0.5, QColor(0, 255, 255));
-                gradient.setColorAt(1.0, QColor(0, 0, 255, 0));
-                p.setBrush(gradient);
-                p.drawEllipse(b.x, b.y, 20, 20);
-            }
-            else
-            {
-                QRadialGradient gradient(b.x + 4, b.y + 4, 6);
-                gradient.setColorAt(0.0, QColor(255, 255, 255));
-                gradient.setColorAt(0.5, QColor(255, 0, 0));
-                gradient.setColorAt(1.0, QColor(100, 0, 0, 0));
-                p.setBrush(gradient);
-                p.drawEllipse(b.x, b.y, 10, 10);
-            }
-        }
+        if (bullets.isEnemy(i))
+            bulletBatch.add(atlas, bullets.isSpecial(i) ? enemySpecial : enemyNormal, bx, by);
         else
-        {
-            bool hasImage = false;
-            if (currentPlaneId < bulletImages.size() && !bulletImages[currentPlaneId].isNull())
-            {
-                p.drawImage(b.x - 5, b.y, bulletImages[currentPlaneId]);
-                hasImage = true;
-            }
-            if (!hasImage)
-            {
-                switch (currentPlaneId)
-                {
-                case PLANE_DEFAULT:
-                {
-                    QLinearGradient g(b.x, b.y, b.x, b.y + 15);
-                    g.setColorAt(0, QColor(255, 255, 200));
-                    g.setColorAt(1, QColor(255, 165, 0));
-                    p.setBrush(g);
-                    p.drawRect(b.x + 2, b.y, 4, 14);
-                    break;
-                }
-                case PLANE_DOUBLE:
-                {
-                    QRadialGradient g(b.x + 4, b.y + 6, 8);
-                    g.setColorAt(0, Qt::white);
-                    g.setColorAt(0.6, QColor(0, 200, 255));
-                    g.setColorAt(1, QColor(0, 0, 255, 0));
-                    p.setBrush(g);
-                    p.drawEllipse(b.x, b.y, 8, 12);
-                    break;
-                }
-                case PLANE_SHOTGUN:
-                {
-                    QRadialGradient g(b.x + 5, b.y + 5, 6);
-                    g.setColorAt(0, Qt::white);
-                    g.setColorAt(0.5, QColor(255, 50, 0));
-                    g.setColorAt(1, QColor(100, 0, 0, 0));
-                    p.setBrush(g);
-                    p.drawEllipse(b.x, b.y, 10, 10);
-                    break;
-                }
-                case PLANE_SNIPER:
-                {
-                    p.setBrush(QColor(200, 0, 255, 100));
-                    p.drawRect(b.x + 1, b.y - 5, 6, 25);
-                    p.setBrush(Qt::white);
-                    p.drawRect(b.x + 3, b.y, 2, 20);
-                    break;
-                }
-                case PLANE_ALIEN:
-                {
-                    QRadialGradient g(b.x + 4, b.y + 4, 6);
-                    g.setColorAt(0, QColor(200, 255, 200));
-                    g.setColorAt(0.5, QColor(0, 255, 0));
-                    g.setColorAt(1, QColor(0, 50, 0, 0));
-                    p.setBrush(g);
-                    p.drawEllipse(b.x, b.y, 8, 8);
-                    break;
-                }
-                }
-            }
-        }
+            bulletBatch.add(atlas, playerBullet, bx, by);
     }
+    bulletBatch.flush(p, atlas);
 
     p.restore(); // === 恢复坐标系 ===
 
+    paintTimer.switchTo(FrameProfiler::PHASE_PAINT_HUD);
+
     if (nukeFlashOpacity > 0)
     {
         p.fillRect(rect(), QColor(255, 255, 255, nukeFlashOpacity));
@@ -786,13 +466,12 @@ void GameWidget::paintEvent(QPaintEvent *event)
     p.setFont(QFont("Arial", 16, QFont::Bold));
     int textMargin = 20;
     p.drawText(textMargin, 40, "Level " + QString::number(currentLevelConfig.levelId));
-    p.drawText(textMargin, 70, "Score: " + QString::number(score));
+    p.drawText(textMargin, 70, "Score: " + QString::number(sim.score()));
 
     p.drawText(textMargin, 100, "HP:");
     p.setBrush(Qt::gray);
     p.drawRect(textMargin + 40, 85, 200, 15);
-    PlaneStats s = DataManager::getFinalStats(currentPlaneId);
-    float hpRatio = (float)heroHp / s.hp;
+    float hpRatio = (float)sim.heroHp() / sim.loadout().maxHp;
     if (hpRatio < 0)
         hpRatio = 0;
     if (hpRatio > 0.3)
@@ -804,13 +483,13 @@ void GameWidget::paintEvent(QPaintEvent *event)
     drawProgressBar(p);
     drawUltUI(p);
 
-    if (isGameOver)
+    if (sim.isGameOver())
     {
         p.setPen(Qt::red);
         p.setFont(QFont("Microsoft YaHei", 40, QFont::Bold));
         p.drawText(rect(), Qt::AlignCenter, "GAME OVER");
     }
-    else if (isVictory)
+    else if (sim.isVictory())
     {
         p.setPen(Qt::yellow);
         p.setFont(QFont("Microsoft YaHei", 40, QFont::Bold));
@@ -818,6 +497,13 @@ void GameWidget::paintEvent(QPaintEvent *event)
         p.setFont(QFont("Arial", 20));
         p.drawText(rect().adjusted(0, 150, 0, 0), Qt::AlignCenter, "Click to Continue");
     }
+
+    paintTimer.stop();
+    if (profiler.isEnabled())
+    {
+        profiler.endFrame();
+        drawProfilerOverlay(p);
+    }
 }
 
 // UI 绘制辅助
@@ -835,10 +521,11 @@ void GameWidget::drawProgressBar(QPainter &p)
     p.setBrush(QColor(0, 20, 40, 200));
     p.drawRect(barX, barY, barWidth, barHeight);
 
+    const LevelConfig &currentLevelConfig = sim.levelConfig();
     float percentage = 0;
     if (currentLevelConfig.totalWaves > 0)
     {
-        percentage = (float)progressCounter / (float)currentLevelConfig.totalWaves;
+        percentage = (float)sim.progressCounter() / (float)currentLevelConfig.totalWaves;
     }
     if (percentage > 1.0f)
         percentage = 1.0f;
@@ -857,7 +544,7 @@ void GameWidget::drawProgressBar(QPainter &p)
     int iconSize = 50;
     int iconX = barX + barWidth / 2 - iconSize / 2;
     int iconY = barY - iconSize - 5;
-    p.drawImage(iconX, iconY, currentBossIcon.scaled(iconSize, iconSize, Qt::KeepAspectRatioByExpanding));
+    p.drawPixmap(iconX, iconY, ScaledPixmapCache::scaled("bossIcon", currentBossIcon, QSize(iconSize, iconSize), devicePixelRatioF(), Qt::KeepAspectRatioByExpanding));
 }
 
 void GameWidget::drawUltUI(QPainter &p)
@@ -871,12 +558,13 @@ void GameWidget::drawUltUI(QPainter &p)
     p.setPen(QPen(Qt::white, 2));
     p.drawEllipse(x, y, iconSize, iconSize);
 
-    QImage icon = imgHero.scaled(iconSize - 20, iconSize - 20, Qt::KeepAspectRatio);
-    int imgX = x + (iconSize - icon.width()) / 2;
-    int imgY = y + (iconSize - icon.height()) / 2;
-    p.drawImage(imgX, imgY, icon);
+    QPixmap icon = ScaledPixmapCache::scaled("ultIcon", imgHero, QSize(iconSize - 20, iconSize - 20), devicePixelRatioF(), Qt::KeepAspectRatio);
+    const QSizeF iconLogical = icon.deviceIndependentSize();
+    int imgX = x + (iconSize - (int)iconLogical.width()) / 2;
+    int imgY = y + (iconSize - (int)iconLogical.height()) / 2;
+    p.drawPixmap(imgX, imgY, icon);
 
-    if (isShieldActive || isTimeFrozen)
+    if (sim.isShieldActive() || sim.isTimeFrozen())
     {
         p.setBrush(Qt::NoBrush);
         p.setPen(QPen(Qt::green, 3));
@@ -887,6 +575,8 @@ void GameWidget::drawUltUI(QPainter &p)
         return;
     }
 
+    const int ULT_COOLDOWN_MAX = GameSimulation::ULT_COOLDOWN_MAX;
+    int ultCooldownTimer = sim.ultCooldownTimer();
     if (ultCooldownTimer < ULT_COOLDOWN_MAX)
     {
         p.setBrush(QColor(0, 0, 0, 200));
@@ -908,104 +598,171 @@ void GameWidget::drawUltUI(QPainter &p)
     p.drawText(x, y + iconSize + 5, iconSize, 20, Qt::AlignCenter, "ULT");
 }
 
+// 性能浮层：最近 HISTORY 帧的帧耗时曲线 + 各阶段平均毫秒数 + 实体数量
+void GameWidget::drawProfilerOverlay(QPainter &p)
+{
+    const int panelW = 260;
+    const int graphH = 60;
+    const int lineH = 14;
+    const int x = 20;
+    const int y = 120;
+    const int lines = 3 + FrameProfiler::PHASE_COUNT;
+    const int panelH = graphH + 16 + lines * lineH;
+
+    p.save();
+    p.setPen(Qt::NoPen);
+    p.setBrush(QColor(0, 0, 0, 170));
+    p.drawRect(x, y, panelW, panelH);
+
+    // 帧耗时曲线：纵轴 0 ~ 33.3ms，虚线为 60Hz 预算
+    const double graphMaxMs = TICK_MS * 2;
+    const int gx = x + 6, gy = y + 6, gw = panelW - 12;
+    p.setPen(QPen(QColor(255, 255, 0, 120), 1, Qt::DashLine));
+    const int budgetY = gy + graphH - (int)(graphH * TICK_MS / graphMaxMs);
+    p.drawLine(gx, budgetY, gx + gw, budgetY);
+
+    const int n = profiler.historySize();
+    if (n > 1)
+    {
+        QPolygonF curve;
+        curve.reserve(n);
+        for (int i = 0; i < n; ++i)
+        {
+            double ms = qMin(profiler.frameMs(i), graphMaxMs);
+            curve.append(QPointF(gx + gw * i / (double)(FrameProfiler::HISTORY - 1),
+                                 gy + graphH - graphH * ms / graphMaxMs));
+        }
+        p.setPen(QPen(QColor(0, 255, 128), 1));
+        p.drawPolyline(curve);
+    }
+
+    // 文字
+    p.setFont(QFont("Consolas", 9));
+    p.setPen(Qt::white);
+    int ty = gy + graphH + 6;
+    auto line = [&](const QString &text)
+    {
+        ty += lineH;
+        p.drawText(gx, ty, text);
+    };
+    const double avgMs = profiler.averageFrameMs();
+    line(QString("frame %1 ms (max %2)  %3 fps")
+             .arg(avgMs, 0, 'f', 2)
+             .arg(profiler.maxFrameMs(), 0, 'f', 2)
+             .arg(avgMs > 0 ? 1000.0 / avgMs : 0, 0, 'f', 0));
+    line(QString("ticks/frame %1").arg(profiler.averageTicksPerFrame(), 0, 'f', 2));
+    line(QString("bullets %1  enemies %2").arg(sim.bullets().size()).arg(sim.enemies().size()));
+    for (int i = 0; i < FrameProfiler::PHASE_COUNT; ++i)
+    {
+        FrameProfiler::Phase phase = (FrameProfiler::Phase)i;
+        p.setPen(FrameProfiler::isPaintPhase(phase) ? QColor(150, 200, 255) : QColor(255, 220, 150));
+        line(QString("%1 %2 ms")
+                 .arg(FrameProfiler::phaseName(phase), -15)
+                 .arg(profiler.averagePhaseMs(phase), 6, 'f', 3));
+    }
+    p.restore();
+}
+
 // 结算逻辑
 void GameWidget::gameOver()
 {
-    if (!isGameOver && !isVictory)
-    {
-        isGameOver = true;
-        if (bossMovie->isValid())
-            bossMovie->setPaused(true);
-        setCursor(Qt::ArrowCursor);
-        int coinsEarned = score / 10;
-        DataManager::addCoins(coinsEarned);
-
-        // 【新增】失败时也可能有掉落装备
-        int dropId = DataManager::generateDrop(currentLevelConfig.levelId);
-        if (dropId > 0 && QRandomGenerator::global()->bounded(100) < 10)
-        { // 10%概率
-            DataManager::addEquipment(dropId);
-        }
+    setCursor(Qt::ArrowCursor);
+    // 回放不结算
+    if (replaying)
+        return;
+    recording.save(Replay::defaultPath());
+    int coinsEarned = sim.score() / 10;
+    DataManager::addCoins(coinsEarned);
+
+    // 【新增】失败时也可能有掉落装备
+    int dropId = DataManager::generateDrop(sim.levelConfig().levelId, sim.rng());
+    if (dropId > 0 && sim.rng().bounded(100) < 10)
+    { // 10%概率
+        DataManager::addEquipment(dropId);
     }
 }
 
 void GameWidget::victory()
 {
-    if (!isVictory && !isGameOver)
-    {
-        isVictory = true;
-        if (bossMovie->isValid())
-            bossMovie->setPaused(true);
-        setCursor(Qt::ArrowCursor);
-        ScoreManager::saveScore(score);
-        LevelManager::unlockNextLevel(currentLevelConfig.levelId);
-        int coinsEarned = score / 10;
-        DataManager::addCoins(coinsEarned);
-
-        // 掉落装备
-        int dropId = DataManager::generateDrop(currentLevelConfig.levelId);
-        if (dropId > 0)
-        {
-            DataManager::addEquipment(dropId);
-            Equipment eq = DataManager::getEquipmentById(dropId);
-            QMessageBox::information(this, "战斗胜利",
-                                     QString("关卡完成！\n获得战利品：%1 金币\n获得装备：[%2] %3")
-                                         .arg(coinsEarned)
-                                         .arg(eq.tier == TIER_EPIC ? "极品" : eq.tier == TIER_RARE ? "优良"
-                                                                                                   : "普通")
-                                         .arg(eq.name));
-        }
+    setCursor(Qt::ArrowCursor);
+    if (replaying)
+        return;
+    recording.save(Replay::defaultPath());
+    int levelId = sim.levelConfig().levelId;
+    ScoreManager::saveScore(sim.score());
+    LevelManager::unlockNextLevel(levelId);
+    int coinsEarned = sim.score() / 10;
+    DataManager::addCoins(coinsEarned);
+
+    // 掉落装备
+    int dropId = DataManager::generateDrop(levelId, sim.rng());
+    if (dropId > 0)
+    {
+        DataManager::addEquipment(dropId);
+        Equipment eq = DataManager::getEquipmentById(dropId);
+        QMessageBox::information(this, "战斗胜利",
+                                 QString("关卡完成！\n获得战利品：%1 金币\n获得装备：[%2] %3")
+                                     .arg(coinsEarned)
+                                     .arg(eq.tier == TIER_EPIC ? "极品" : eq.tier == TIER_RARE ? "优良"
+                                                                                               : "普通")
+                                     .arg(eq.name));
     }
 }
 
 // 输入映射
+// 输入只记录，下一逻辑帧统一提交给 GameSimulation
 void GameWidget::mouseMoveEvent(QMouseEvent *event)
 {
-    if (isGameOver || isVictory)
+    if (sim.isFinished())
         return;
     QPointF gamePos = mapToGame(event->pos());
-    double targetX = gamePos.x() - imgHero.width() / 2;
-    double targetY = gamePos.y() - imgHero.height() / 2;
-    if (targetX < 0)
-        targetX = 0;
-    if (targetX > getGameWidth() - imgHero.width())
-        targetX = getGameWidth() - imgHero.width();
-    if (targetY < 0)
-        targetY = 0;
-    if (targetY > LOGICAL_HEIGHT - imgHero.height())
-        targetY = LOGICAL_HEIGHT - imgHero.height();
-    heroX = targetX;
-    heroY = targetY;
+    pendingInput.targetX = gamePos.x();
+    pendingInput.targetY = gamePos.y();
 }
 
 void GameWidget::mousePressEvent(QMouseEvent *event)
 {
-    if (isGameOver || isVictory)
+    if (sim.isFinished())
         return;
     if (event->button() == Qt::LeftButton)
     {
-        fireUlt();
+        pendingInput.ultPressed = true;
     }
 }
 
 void GameWidget::mouseReleaseEvent(QMouseEvent *event)
 {
-    if (isGameOver)
+    if (sim.isGameOver())
         emit gameEnded();
-    else if (isVictory)
+    else if (sim.isVictory())
         emit levelWon();
 }
 
-void GameWidget::keyPressEvent(QKeyEvent *event) {}
-
-void GameWidget::cleanUp()
+void GameWidget::keyPressEvent(QKeyEvent *event)
 {
-    QMutableListIterator<Bullet> i(bullets);
-    while (i.hasNext())
-        if (!i.next().active)
-            i.remove();
-    QMutableListIterator<Enemy> j(enemies);
-    while (j.hasNext())
-        if (!j.next().active)
-            j.remove();
-}
\ No newline at end of file
+    // F3：性能浮层
+    if (event->key() == Qt::Key_F3)
+    {
+        profiler.setEnabled(!profiler.isEnabled());
+        update();
+        return;
+    }
+    // F4：第一次按开始事件追踪，再按一次导出 trace JSON 并停止
+    if (event->key() == Qt::Key_F4)
+    {
+        if (!TraceRecorder::isEnabled())
+        {
+            TraceRecorder::clear();
+            TraceRecorder::setEnabled(true);
+        }
+        else
+        {
+            TraceRecorder::setEnabled(false);
+            const QString path = TraceRecorder::defaultPath();
+            if (!TraceRecorder::writeJson(path))
+                qWarning() << "无法写入事件追踪:" << path;
+        }
+        return;
+    }
+    QWidget::keyPressEvent(event);
+}
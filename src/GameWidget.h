@@ -4,13 +4,17 @@
 #include <QWidget>
 #include <QMediaPlayer>
 #include <QAudioOutput>
-#include <QSoundEffect>
 #include <QTimer>
 #include <QList>
 #include <QImage>
-#include <QMovie>
+#include <QElapsedTimer>
 #include "common.h"
-#include "BossStrategy.h"
+#include "GameSimulation.h"
+#include "Replay.h"
+#include "FrameProfiler.h"
+#include "BulletSprites.h"
+#include "BossAnimation.h"
+#include "AudioMixer.h"
 
 class GameWidget : public QWidget
 {
@@ -18,6 +22,9 @@ class GameWidget : public QWidget
 public:
     explicit GameWidget(QWidget *parent = nullptr);
     void startGame(int level);
+    void startReplay(const Replay &replay);
+    // 压力测试参数 (命令行 --stress / --spawn)，对之后开始的每一局生效
+    void setStressConfig(const StressConfig &config) { stress = config; }
     void stopGame();
 
 signals:
@@ -30,22 +37,24 @@ protected:
     void mouseReleaseEvent(QMouseEvent *event) override;
     void keyPressEvent(QKeyEvent *event) override;
     void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
 
 private:
     void loadAssets();
+    void prepareRun(int level, int planeId);
+    void ensureAtlas(qreal deviceScale);
+    void beginLoop();
     void updateGame();
-    void spawnEnemy();
-    void spawnBoss();
-    void checkCollisions();
+    void handleEvents(const GameEvents &events);
+    void onBossSpawned();
     void drawProgressBar(QPainter &p);
     void drawUltUI(QPainter &p);
-    void fireUlt();
+    void drawProfilerOverlay(QPainter &p);
     void gameOver();
     void victory();
-    void cleanUp();
 
     // --- 分辨率适配辅助 ---
-    const int LOGICAL_HEIGHT = 600;
+    const int LOGICAL_HEIGHT = GameSimulation::LOGICAL_HEIGHT;
     double getGameWidth();
     double getGameScale();
     void getScaleOffset(double &scale, double &offsetX, double &offsetY);
@@ -55,56 +64,54 @@ private:
     QImage imgHero, imgEnemy1, imgEnemy2, imgEnemy3, imgBg;
     QImage currentBossIcon;
 
-    QList<QImage> bulletImages;
+    BulletSprites bulletSprites; // 子弹外观 (预渲染)
 
-    // 音频
-    QSoundEffect *shootSfx;
-    QSoundEffect *explodeSfx;
+    // 精灵图集：战机 / 敌人 / 子弹打包进同一组大贴图，同页精灵一次 drawPixmapFragments 提交
+    SpriteAtlas atlas;
+    SpriteBatch entityBatch, bulletBatch;
+    qreal atlasScale = 0;   // 图集对应的设备缩放 (逻辑缩放 x devicePixelRatio)
+    bool atlasDirty = true; // 战机 / 子弹贴图变化后需要重建
+    int spriteHero = -1;
+    int spriteEnemy[3] = {-1, -1, -1}; // 下标为敌人 type
 
-    // 【核心修改】大招音效列表
-    QList<QSoundEffect *> ultSfxList;
+    // 音频
+    AudioMixer *sfxMixer; // 音效在独立音频线程混音
+    int sfxShoot, sfxExplode;
+    QList<int> sfxUlt; // 大招音效列表 (下标为战机编号)
 
     QMediaPlayer *bgmPlayer;
     QAudioOutput *bgmOutput;
 
-    // BOSS 动画
-    QMovie *bossMovie;
+    // BOSS 动画 (后台预解码的帧，按逻辑帧播放)
+    static const int BOSS_ANIM_WIDTH = 200;
+    static const int BOSS_ANIM_HEIGHT = 150;
+    BossAnimation bossAnimation;
+    int bossSpawnTick = 0; // BOSS 登场时的逻辑帧号
 
     QTimer *gameTimer;
 
-    // 游戏状态
-    double heroX, heroY;
-    int heroHp, score;
-    bool isGameOver;
-    bool isVictory;
-    QList<Bullet> bullets;
-    QList<Enemy> enemies;
-
-    int heroShootTimer;
-    LevelConfig currentLevelConfig;
-    int progressCounter;
-    bool bossSpawned;
-    int enemySpawnTimer;
-
-    // 策略模块
-    BossStrategy bossStrategy;
-
-    // --- 战机与技能系统 ---
-    int currentPlaneId;
-
-    // 技能状态
-    bool isUltActive;
-    int ultDurationTimer;
-    int ultCooldownTimer;
-    int ULT_COOLDOWN_MAX;
-
-    bool isShieldActive;
-    int shieldTimer;
-
-    bool isTimeFrozen;
-    int freezeTimer;
-
-    int nukeFlashOpacity;
+    // --- 固定步长主循环 ---
+    // 逻辑固定 60Hz 推进 (与原 16ms 定时器的"每帧"速度含义一致)，渲染按显示刷新率插值
+    static constexpr double TICK_MS = 1000.0 / 60.0;
+    static const int MAX_CATCHUP_TICKS = 5; // 单次最多补帧数，超出的积压直接丢弃
+    QElapsedTimer frameClock;
+    qint64 lastFrameNs;
+    double tickAccumulator; // 尚未消耗的真实时间 (毫秒)
+    double renderAlpha;     // 当前渲染帧位于两逻辑帧之间的比例 [0, 1)
+
+    // 游戏逻辑 (无界面核心)，本类只负责输入、渲染与音画表现
+    GameSimulation sim;
+    GameInput pendingInput; // 下一逻辑帧要提交的输入
+
+    // --- 输入录像 ---
+    Replay recording;       // 本局录像 (结算时写入 Replay::defaultPath())
+    Replay playback;        // 正在回放的录像
+    bool replaying = false; // 为 true 时输入取自 playback
+    int replayTick = 0;     // 下一帧要回放的帧号
+    StressConfig stress;    // 压力测试参数 (默认即正常游戏)
+
+    // --- 性能浮层 (F3 开关) ---
+    FrameProfiler profiler; // 逻辑帧 / 绘制分阶段耗时
 };
 
 #endif // GAMEWIDGET_H
\ No newline at end of file
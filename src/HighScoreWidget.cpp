@@ -1,4 +1,5 @@
 #include "HighScoreWidget.h"
+#include "ScaledPixmapCache.h"
 #include "ScoreManager.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -9,7 +10,7 @@
 
 HighScoreWidget::HighScoreWidget(QWidget *parent) : QWidget(parent)
 {
-    bgImg.load("assets/game_bg.png");
+    bgImg = ScaledPixmapCache::image("assets/game_bg.png");
 
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
     mainLayout->setContentsMargins(50, 40, 50, 40);
@@ -119,7 +120,7 @@ void HighScoreWidget::paintEvent(QPaintEvent *)
     QPainter p(this);
     if (!bgImg.isNull())
     {
-        p.drawImage(rect(), bgImg);
+        p.drawPixmap(0, 0, ScaledPixmapCache::scaled("bg", bgImg, size(), devicePixelRatioF()));
         p.fillRect(rect(), QColor(0, 0, 0, 50));
     }
     else
@@ -0,0 +1,70 @@
+#ifndef HITBOX_H
+#define HITBOX_H
+
+// 轴对齐包围盒 (逻辑坐标，左闭右开)
+struct Aabb
+{
+    float left, top, right, bottom;
+
+    bool intersects(const Aabb &o) const
+    {
+        return left < o.right && o.left < right && top < o.bottom && o.top < bottom;
+    }
+    bool contains(float x, float y) const
+    {
+        return x >= left && x < right && y >= top && y < bottom;
+    }
+};
+
+// 碰撞盒：相对实体左上角的偏移与尺寸
+struct Hitbox
+{
+    float dx, dy, w, h;
+
+    Aabb at(double x, double y) const
+    {
+        Aabb box;
+        box.left = (float)x + dx;
+        box.top = (float)y + dy;
+        box.right = box.left + w;
+        box.bottom = box.top + h;
+        return box;
+    }
+};
+
+// 各类敌人的碰撞盒表
+// 与贴图解码无关：数值即贴图缩放后的显示尺寸 (enemy.png 50x50, enemy3.png 120x120)
+struct HitboxTable
+{
+    Hitbox smallEnemy; // type 0 / 1
+    Hitbox largeEnemy; // type 2
+    Hitbox bossInner;  // BOSS 受击内框 (子弹 / 激光)
+    Hitbox bossBody;   // BOSS 撞击框 (比内框更小，贴身才算撞上)
+
+    static HitboxTable defaults()
+    {
+        HitboxTable t;
+        t.smallEnemy = {0, 0, 50, 50};
+        t.largeEnemy = {0, 0, 120, 120};
+        t.bossInner = {20, 20, 160, 110};
+        t.bossBody = {40, 40, 120, 80};
+        return t;
+    }
+
+    // 子弹 / 激光判定用
+    const Hitbox &hitBox(int type) const
+    {
+        if (type == 10)
+            return bossInner;
+        return type == 2 ? largeEnemy : smallEnemy;
+    }
+    // 身体撞击判定用
+    const Hitbox &bodyBox(int type) const
+    {
+        if (type == 10)
+            return bossBody;
+        return type == 2 ? largeEnemy : smallEnemy;
+    }
+};
+
+#endif // HITBOX_H
@@ -1,4 +1,5 @@
 #include "LevelManager.h"
+#include "TraceRecorder.h"
 #include <QFile>
 #include <QTextStream>
 #include <QCoreApplication>
@@ -28,6 +29,7 @@ void LevelManager::unlockNextLevel(int currentLevel)
     // 如果通关了6，就不再解锁了（或者你可以写 < 7 开启二周目）
     if (currentLevel >= max && currentLevel < 6)
     {
+        TraceScope trace("save", "LevelManager::unlockNextLevel");
         QFile file(getSavePath());
         if (file.open(QIODevice::WriteOnly))
         {
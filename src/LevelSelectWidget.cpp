@@ -1,4 +1,5 @@
 #include "LevelSelectWidget.h"
+#include "ScaledPixmapCache.h"
 #include "LevelManager.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -7,7 +8,7 @@
 
 LevelSelectWidget::LevelSelectWidget(QWidget *parent) : QWidget(parent)
 {
-    bgImg.load("assets/game_bg.png");
+    bgImg = ScaledPixmapCache::image("assets/game_bg.png");
 
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
     mainLayout->setAlignment(Qt::AlignCenter);
@@ -87,7 +88,7 @@ void LevelSelectWidget::paintEvent(QPaintEvent *)
 {
     QPainter p(this);
     if (!bgImg.isNull())
-        p.drawImage(rect(), bgImg);
+        p.drawPixmap(0, 0, ScaledPixmapCache::scaled("bg", bgImg, size(), devicePixelRatioF()));
     else
         p.fillRect(rect(), Qt::black);
 }
\ No newline at end of file
@@ -1,86 +1,195 @@
 #include "MainWindow.h"
 #include "DataManager.h"
+#include "StartupTimeline.h"
+#include "TraceRecorder.h"
 #include <QVBoxLayout>
+#include <QEvent>
+#include <QTimer>
 #include <QDebug>
 
-MainWindow::MainWindow(QWidget *parent) : QWidget(parent)
+MainWindow::MainWindow(QWidget *parent)
+    : QWidget(parent),
+      planeSelect(nullptr),
+      levelSelect(nullptr),
+      game(nullptr),
+      highScore(nullptr),
+      shop(nullptr),
+      equipment(nullptr)
 {
     resize(960, 600);
     setMinimumSize(960, 600);
     setWindowTitle("Qt Space Shooter - Ultimate Edition");
 
     DataManager::loadData();
+    StartupTimeline::mark("DataManager::loadData");
 
     stack = new QStackedWidget(this);
     QVBoxLayout *layout = new QVBoxLayout(this);
     layout->setContentsMargins(0, 0, 0, 0);
     layout->addWidget(stack);
 
-    // 初始化所有页面
+    // 启动时只建菜单页，其余页面第一次进入时再创建 (见 xxxPage())
     menu = new MenuWidget(this);
-    planeSelect = new PlaneSelectWidget(this);
-    levelSelect = new LevelSelectWidget(this);
-    game = new GameWidget(this);
-    highScore = new HighScoreWidget(this);
-    shop = new ShopWidget(this);           // 初始化商店
-    equipment = new EquipmentWidget(this); // 初始化装备
-
-    // 加入堆栈
-    stack->addWidget(menu);        // 0
-    stack->addWidget(planeSelect); // 1
-    stack->addWidget(levelSelect); // 2
-    stack->addWidget(game);        // 3
-    stack->addWidget(highScore);   // 4
-    stack->addWidget(shop);        // 5 (商店页面)
-    stack->addWidget(equipment);   // 6 (装备页面)
+    stack->addWidget(menu);
+    StartupTimeline::mark("MenuWidget");
+
+    // 菜单第一次绘制即首帧，结束启动时间线
+    menu->installEventFilter(this);
 
     // --- 信号连接 ---
 
     // 菜单跳转
     connect(menu, &MenuWidget::startClicked, this, [this]()
-            { menu->stopMenu(); levelSelect->refreshState(); stack->setCurrentWidget(levelSelect); });
+            { menu->stopMenu(); levelSelectPage()->refreshState(); stack->setCurrentWidget(levelSelect); });
     connect(menu, &MenuWidget::garageClicked, this, [this]()
-            { menu->stopMenu(); planeSelect->refreshUI(); stack->setCurrentWidget(planeSelect); });
+            { menu->stopMenu(); planeSelectPage()->refreshUI(); stack->setCurrentWidget(planeSelect); });
     connect(menu, &MenuWidget::equipClicked, this, [this]() { // 跳转装备
         menu->stopMenu();
-        equipment->refreshUI();
+        equipmentPage()->refreshUI();
         stack->setCurrentWidget(equipment);
     });
     connect(menu, &MenuWidget::shopClicked, this, [this]() { // 跳转商店
         menu->stopMenu();
-        shop->refreshUI();
+        shopPage()->refreshUI();
         stack->setCurrentWidget(shop);
     });
     connect(menu, &MenuWidget::historyClicked, this, [this]()
             {
-        highScore->refreshScores(); stack->setCurrentWidget(highScore); });
+        highScorePage()->refreshScores(); stack->setCurrentWidget(highScore); });
+
+    menu->startMenu();
+}
 
-    // 各子页面返回菜单
-    auto backToMenu = [this]()
+bool MainWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == menu && event->type() == QEvent::Paint)
     {
-        stack->setCurrentWidget(menu);
-        menu->startMenu();
-    };
-    connect(planeSelect, &PlaneSelectWidget::backClicked, this, backToMenu);
-    connect(levelSelect, &LevelSelectWidget::backClicked, this, backToMenu);
-    connect(highScore, &HighScoreWidget::backClicked, this, backToMenu);
-    connect(shop, &ShopWidget::backClicked, this, backToMenu);
-    connect(equipment, &EquipmentWidget::backClicked, this, backToMenu);
-
-    // 【关键】选择关卡后启动游戏
-    connect(levelSelect, &LevelSelectWidget::levelSelected, this, [this](int level)
-            {
-        game->startGame(level);
-        stack->setCurrentWidget(game); });
-
-    // 游戏流程
-    connect(game, &GameWidget::gameEnded, this, [this, backToMenu]()
-            { game->stopGame(); backToMenu(); });
-    connect(game, &GameWidget::levelWon, this, [this]()
-            { 
-        game->stopGame(); 
-        levelSelect->refreshState(); 
-        stack->setCurrentWidget(levelSelect); });
+        menu->removeEventFilter(this);
+        // 排到本次绘制之后再记，计入菜单首帧自身的绘制耗时
+        QTimer::singleShot(0, this, []()
+                           { StartupTimeline::finish("first menu frame"); });
+    }
+    return QWidget::eventFilter(watched, event);
+}
 
+// 各子页面返回菜单
+void MainWindow::backToMenu()
+{
+    stack->setCurrentWidget(menu);
     menu->startMenu();
-}
\ No newline at end of file
+}
+
+PlaneSelectWidget *MainWindow::planeSelectPage()
+{
+    if (!planeSelect)
+    {
+        TraceScope trace("page", "create", "PlaneSelectWidget");
+        planeSelect = new PlaneSelectWidget(this);
+        stack->addWidget(planeSelect);
+        connect(planeSelect, &PlaneSelectWidget::backClicked, this, &MainWindow::backToMenu);
+    }
+    return planeSelect;
+}
+
+LevelSelectWidget *MainWindow::levelSelectPage()
+{
+    if (!levelSelect)
+    {
+        TraceScope trace("page", "create", "LevelSelectWidget");
+        levelSelect = new LevelSelectWidget(this);
+        stack->addWidget(levelSelect);
+        connect(levelSelect, &LevelSelectWidget::backClicked, this, &MainWindow::backToMenu);
+
+        // 【关键】选择关卡后启动游戏
+        connect(levelSelect, &LevelSelectWidget::levelSelected, this, [this](int level)
+                {
+            gamePage()->startGame(level);
+            stack->setCurrentWidget(game); });
+    }
+    return levelSelect;
+}
+
+GameWidget *MainWindow::gamePage()
+{
+    if (!game)
+    {
+        TraceScope trace("page", "create", "GameWidget");
+        game = new GameWidget(this);
+        game->setStressConfig(stress);
+        stack->addWidget(game);
+        game->resize(stack->size()); // 堆栈布局要到下一轮事件才排版，开局时画面宽度 / 缩放需要正确的尺寸
+
+        // 游戏流程
+        connect(game, &GameWidget::gameEnded, this, [this]()
+                { game->stopGame(); backToMenu(); });
+        connect(game, &GameWidget::levelWon, this, [this]()
+                { 
+            game->stopGame(); 
+            levelSelectPage()->refreshState(); 
+            stack->setCurrentWidget(levelSelect); });
+    }
+    return game;
+}
+
+HighScoreWidget *MainWindow::highScorePage()
+{
+    if (!highScore)
+    {
+        TraceScope trace("page", "create", "HighScoreWidget");
+        highScore = new HighScoreWidget(this);
+        stack->addWidget(highScore);
+        connect(highScore, &HighScoreWidget::backClicked, this, &MainWindow::backToMenu);
+    }
+    return highScore;
+}
+
+ShopWidget *MainWindow::shopPage()
+{
+    if (!shop)
+    {
+        TraceScope trace("page", "create", "ShopWidget");
+        shop = new ShopWidget(this);
+        stack->addWidget(shop);
+        connect(shop, &ShopWidget::backClicked, this, &MainWindow::backToMenu);
+    }
+    return shop;
+}
+
+EquipmentWidget *MainWindow::equipmentPage()
+{
+    if (!equipment)
+    {
+        TraceScope trace("page", "create", "EquipmentWidget");
+        equipment = new EquipmentWidget(this);
+        stack->addWidget(equipment);
+        connect(equipment, &EquipmentWidget::backClicked, this, &MainWindow::backToMenu);
+    }
+    return equipment;
+}
+
+bool MainWindow::playReplay(const QString &path)
+{
+    Replay replay;
+    if (!replay.load(path))
+    {
+        qWarning() << "无法读取录像:" << path;
+        return false;
+    }
+    // 启动时直接回放：菜单首帧不会出现，在这里结束启动时间线
+    if (!StartupTimeline::isFinished())
+    {
+        menu->removeEventFilter(this);
+        StartupTimeline::abort("replay start");
+    }
+    menu->stopMenu();
+    gamePage()->startReplay(replay);
+    stack->setCurrentWidget(game);
+    return true;
+}
+
+void MainWindow::setStressConfig(const StressConfig &config)
+{
+    stress = config;
+    if (game)
+        game->setStressConfig(config);
+}
@@ -17,7 +17,24 @@ class MainWindow : public QWidget
 public:
     explicit MainWindow(QWidget *parent = nullptr);
 
+    // 直接进入录像回放 (命令行 --replay)，录像无法读取时返回 false
+    bool playReplay(const QString &path);
+    // 压力测试参数，转交给游戏页
+    void setStressConfig(const StressConfig &config);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private:
+    // 页面在第一次跳转时才创建 (菜单页除外)，创建时加入堆栈并连好信号
+    PlaneSelectWidget *planeSelectPage();
+    LevelSelectWidget *levelSelectPage();
+    GameWidget *gamePage();
+    HighScoreWidget *highScorePage();
+    ShopWidget *shopPage();
+    EquipmentWidget *equipmentPage();
+    void backToMenu();
+
     QStackedWidget *stack;
     MenuWidget *menu;
     PlaneSelectWidget *planeSelect;
@@ -26,6 +43,7 @@ private:
     HighScoreWidget *highScore;
     ShopWidget *shop;
     EquipmentWidget *equipment;
+    StressConfig stress; // 游戏页尚未创建时先存着
 };
 
 #endif // MAINWINDOW_H
\ No newline at end of file
@@ -1,17 +1,19 @@
 #include "PlaneSelectWidget.h"
+#include "ScaledPixmapCache.h"
+#include "AssetManager.h"
 #include "DataManager.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QPainter>
 #include <QMessageBox>
-#include <QFileInfo>
+#include <QPixmap>
 #include <QDebug>
 #include <QScrollArea>
 #include <QScrollBar>
 
 PlaneSelectWidget::PlaneSelectWidget(QWidget *parent) : QWidget(parent)
 {
-    bgImg.load("assets/game_bg.png");
+    bgImg = ScaledPixmapCache::image("assets/game_bg.png");
     selectedPreviewId = 0;
 
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
@@ -40,13 +42,8 @@ PlaneSelectWidget::PlaneSelectWidget(QWidget *parent) : QWidget(parent)
         btn->setFixedSize(100, 100);
         btn->setStyleSheet("background-color: rgba(0,0,0,150); border: 2px solid #555; border-radius: 10px;");
 
-        QString imgPath = QString("assets/plane%1.png").arg(i);
-        if (i == 0)
-            imgPath = "assets/hero.png";
-        if (!QFileInfo::exists(imgPath))
-            imgPath = "assets/hero.png";
-
-        btn->setIcon(QIcon(imgPath));
+        // 图标用预加载好的 80x80 副本，避免按钮绘制时再解码原图
+        btn->setIcon(QIcon(QPixmap::fromImage(AssetManager::image(AssetManager::planePath(i), QSize(80, 80)))));
         btn->setIconSize(QSize(80, 80));
         btn->setCursor(Qt::PointingHandCursor);
 
@@ -269,7 +266,7 @@ void PlaneSelectWidget::paintEvent(QPaintEvent *)
 {
     QPainter p(this);
     if (!bgImg.isNull())
-        p.drawImage(rect(), bgImg);
+        p.drawPixmap(0, 0, ScaledPixmapCache::scaled("bg", bgImg, size(), devicePixelRatioF()));
     else
         p.fillRect(rect(), Qt::black);
 }
\ No newline at end of file
@@ -0,0 +1,317 @@
+#include "Replay.h"
+#include "TraceRecorder.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QtMath>
+#include <cstring>
+
+namespace
+{
+    const char MAGIC[4] = {'S', 'W', 'R', 'P'};
+    const quint8 VERSION = 1;
+
+    // 每帧首个 varint 的低 2 位
+    const quint32 BIT_ULT = 0x1;
+    const quint32 BIT_WIDTH = 0x2;
+
+    quint32 zigzag(qint32 v) { return ((quint32)v << 1) ^ (quint32)(v >> 31); }
+    qint32 unzigzag(quint32 v) { return (qint32)(v >> 1) ^ -(qint32)(v & 1); }
+
+    void writeVarint(QByteArray &out, quint64 v)
+    {
+        while (v >= 0x80)
+        {
+            out.append((char)(v | 0x80));
+            v >>= 7;
+        }
+        out.append((char)v);
+    }
+
+    void writeFixed64(QByteArray &out, quint64 v)
+    {
+        for (int i = 0; i < 8; ++i)
+            out.append((char)(v >> (i * 8)));
+    }
+
+    void writeDouble(QByteArray &out, double d)
+    {
+        quint64 bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        writeFixed64(out, bits);
+    }
+
+    // 顺序读取器：越界后 ok 置为 false，后续读取均返回 0
+    struct Reader
+    {
+        const QByteArray &data;
+        int pos;
+        bool ok;
+
+        quint64 varint()
+        {
+            quint64 v = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                if (pos >= data.size())
+                    break;
+                quint8 b = (quint8)data[pos++];
+                v |= (quint64)(b & 0x7F) << shift;
+                if (!(b & 0x80))
+                    return v;
+            }
+            ok = false;
+            return 0;
+        }
+
+        quint64 fixed64()
+        {
+            if (pos + 8 > data.size())
+            {
+                ok = false;
+                return 0;
+            }
+            quint64 v = 0;
+            for (int i = 0; i < 8; ++i)
+                v |= (quint64)(quint8)data[pos++] << (i * 8);
+            return v;
+        }
+
+        double float64()
+        {
+            quint64 bits = fixed64();
+            double d;
+            std::memcpy(&d, &bits, sizeof(d));
+            return d;
+        }
+
+        qint32 sint() { return unzigzag((quint32)varint()); }
+    };
+}
+
+Replay::Replay()
+    : m_seed(0),
+      m_config(),
+      m_heroSize(60, 60),
+      m_initialWidth(960)
+{
+}
+
+GameInput Replay::quantize(const GameInput &input)
+{
+    GameInput q = input;
+    // 逻辑核心会把英雄夹回画面内，限制范围不影响结果，只是保证录像里的坐标可解码
+    q.targetX = qRound(qBound(-(double)MAX_COORD, input.targetX, (double)MAX_COORD) * SUBPIXEL) / (double)SUBPIXEL;
+    q.targetY = qRound(qBound(-(double)MAX_COORD, input.targetY, (double)MAX_COORD) * SUBPIXEL) / (double)SUBPIXEL;
+    return q;
+}
+
+QString Replay::defaultPath()
+{
+    return QCoreApplication::applicationDirPath() + "/last_replay.swr";
+}
+
+void Replay::begin(quint64 seed, const LevelConfig &config, const LoadoutSnapshot &loadout,
+                   const StressConfig &stress, const QSize &heroSize, double gameWidth)
+{
+    m_seed = seed;
+    m_config = config;
+    m_loadout = loadout;
+    m_stress = stress;
+    m_heroSize = heroSize;
+    m_initialWidth = gameWidth;
+    m_frames.clear();
+}
+
+void Replay::recordTick(const GameInput &input, double gameWidth)
+{
+    ReplayFrame f;
+    f.x = qRound(input.targetX * SUBPIXEL);
+    f.y = qRound(input.targetY * SUBPIXEL);
+    f.ultPressed = input.ultPressed;
+    f.gameWidth = gameWidth;
+    m_frames.append(f);
+}
+
+void Replay::startSimulation(GameSimulation &sim) const
+{
+    sim.setHeroSize(m_heroSize);
+    sim.setGameWidth(m_initialWidth);
+    sim.setStressConfig(m_stress);
+    sim.start(m_config, m_loadout, m_seed);
+}
+
+GameInput Replay::applyTick(int tick, GameSimulation &sim) const
+{
+    const ReplayFrame &f = m_frames[tick];
+    sim.setGameWidth(f.gameWidth);
+
+    GameInput input;
+    input.targetX = f.x / (double)SUBPIXEL;
+    input.targetY = f.y / (double)SUBPIXEL;
+    input.ultPressed = f.ultPressed;
+    return input;
+}
+
+// 格式：
+//   "SWRP" 版本(1B) 种子(8B)
+//   关卡: levelId totalWaves enemyHpScale bossHp (varint)
+//   配置: planeId core armor engine maxHp shootInterval bulletDamage (zigzag varint) speed fireRate (double)
+//   压力: emissionMultiplier spawnInterval bulletCapacity enemyCapacity (zigzag varint)
+//   英雄宽 高 (varint) 初始画面宽度 (double) 帧数 (varint)
+//   每帧: varint(zigzag(dx) << 2 | 宽度变化位 | 大招位) varint(zigzag(dy)) [新宽度 (double)]
+QByteArray Replay::encode() const
+{
+    QByteArray out;
+    out.reserve(64 + m_frames.size() * 2);
+    out.append(MAGIC, sizeof(MAGIC));
+    out.append((char)VERSION);
+    writeFixed64(out, m_seed);
+
+    writeVarint(out, zigzag(m_config.levelId));
+    writeVarint(out, zigzag(m_config.totalWaves));
+    writeVarint(out, zigzag(m_config.enemyHpScale));
+    writeVarint(out, zigzag(m_config.bossHp));
+
+    writeVarint(out, zigzag(m_loadout.planeId));
+    writeVarint(out, zigzag(m_loadout.coreId));
+    writeVarint(out, zigzag(m_loadout.armorId));
+    writeVarint(out, zigzag(m_loadout.engineId));
+    writeVarint(out, zigzag(m_loadout.maxHp));
+    writeVarint(out, zigzag(m_loadout.shootInterval));
+    writeVarint(out, zigzag(m_loadout.bulletDamage));
+    writeDouble(out, m_loadout.speed);
+    writeDouble(out, m_loadout.fireRate);
+
+    writeVarint(out, zigzag(m_stress.emissionMultiplier));
+    writeVarint(out, zigzag(m_stress.spawnInterval));
+    writeVarint(out, zigzag(m_stress.bulletCapacity));
+    writeVarint(out, zigzag(m_stress.enemyCapacity));
+
+    writeVarint(out, zigzag(m_heroSize.width()));
+    writeVarint(out, zigzag(m_heroSize.height()));
+    writeDouble(out, m_initialWidth);
+    writeVarint(out, m_frames.size());
+
+    qint32 lastX = 0, lastY = 0;
+    double lastWidth = m_initialWidth;
+    for (const ReplayFrame &f : m_frames)
+    {
+        const bool widthChanged = (f.gameWidth != lastWidth);
+        quint64 head = (quint64)zigzag(f.x - lastX) << 2;
+        if (f.ultPressed)
+            head |= BIT_ULT;
+        if (widthChanged)
+            head |= BIT_WIDTH;
+        writeVarint(out, head);
+        writeVarint(out, zigzag(f.y - lastY));
+        if (widthChanged)
+            writeDouble(out, f.gameWidth);
+
+        lastX = f.x;
+        lastY = f.y;
+        lastWidth = f.gameWidth;
+    }
+    return out;
+}
+
+bool Replay::decode(const QByteArray &data)
+{
+    if (data.size() < 5 || std::memcmp(data.constData(), MAGIC, sizeof(MAGIC)) != 0)
+        return false;
+    if ((quint8)data[4] != VERSION)
+        return false;
+
+    Reader in = {data, 5, true};
+    quint64 seed = in.fixed64();
+
+    LevelConfig config;
+    config.levelId = in.sint();
+    config.totalWaves = in.sint();
+    config.enemyHpScale = in.sint();
+    config.bossHp = in.sint();
+
+    LoadoutSnapshot loadout;
+    loadout.planeId = in.sint();
+    loadout.coreId = in.sint();
+    loadout.armorId = in.sint();
+    loadout.engineId = in.sint();
+    loadout.maxHp = in.sint();
+    loadout.shootInterval = in.sint();
+    loadout.bulletDamage = in.sint();
+    loadout.speed = in.float64();
+    loadout.fireRate = in.float64();
+
+    StressConfig stress;
+    stress.emissionMultiplier = in.sint();
+    stress.spawnInterval = in.sint();
+    stress.bulletCapacity = in.sint();
+    stress.enemyCapacity = in.sint();
+    if (!stress.isValid())
+        return false; // 损坏的录像可能要求超大的预分配
+
+    int heroW = in.sint();
+    int heroH = in.sint();
+    // 英雄尺寸决定判定框，不能为空也不能大过画面
+    if (heroW <= 0 || heroH <= 0 || heroW > GameSimulation::LOGICAL_HEIGHT || heroH > GameSimulation::LOGICAL_HEIGHT)
+        return false;
+    const double initialWidth = in.float64();
+    quint64 count = in.varint();
+    // 每帧至少 2 字节，借此拒绝损坏的帧数
+    if (!in.ok || count > (quint64)(data.size() - in.pos) / 2)
+        return false;
+
+    QVector<ReplayFrame> frames;
+    frames.reserve((int)count);
+    // 用 64 位累加差分，损坏的文件不会让坐标溢出
+    const qint64 maxSubpixel = (qint64)MAX_COORD * SUBPIXEL;
+    qint64 x = 0, y = 0;
+    double width = initialWidth;
+    for (quint64 i = 0; i < count && in.ok; ++i)
+    {
+        quint64 head = in.varint();
+        x += unzigzag((quint32)(head >> 2));
+        y += in.sint();
+        if (x < -maxSubpixel || x > maxSubpixel || y < -maxSubpixel || y > maxSubpixel)
+            return false;
+        if (head & BIT_WIDTH)
+            width = in.float64();
+
+        ReplayFrame f;
+        f.x = (qint32)x;
+        f.y = (qint32)y;
+        f.ultPressed = (head & BIT_ULT) != 0;
+        f.gameWidth = width;
+        frames.append(f);
+    }
+    if (!in.ok)
+        return false;
+
+    m_seed = seed;
+    m_config = config;
+    m_loadout = loadout;
+    m_stress = stress;
+    m_heroSize = QSize(heroW, heroH);
+    m_initialWidth = initialWidth;
+    m_frames = frames;
+    return true;
+}
+
+bool Replay::save(const QString &path) const
+{
+    TraceScope trace("save", "Replay::save");
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    const QByteArray data = encode();
+    bool ok = file.write(data) == data.size();
+    file.close();
+    return ok;
+}
+
+bool Replay::load(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    return decode(file.readAll());
+}
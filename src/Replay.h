@@ -0,0 +1,72 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "common.h"
+#include "GameSimulation.h"
+#include <QByteArray>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+// 一个逻辑帧的录像数据
+struct ReplayFrame
+{
+    qint32 x, y;      // 指针 (英雄中心) 位置，单位 1 / Replay::SUBPIXEL 逻辑像素
+    bool ultPressed;  // 本帧是否按下大招
+    double gameWidth; // 本帧逻辑画面宽度 (窗口缩放会改变它)
+};
+
+// 输入录像
+// 文件头记录种子 / 关卡 / 出击配置 / 压力参数 / 英雄尺寸，之后是逐帧输入流：
+// 坐标按帧差分后 zigzag + varint 编码，静止或小幅移动时每帧约 2 字节。
+// 录制时逻辑核心吃的是量化后的输入，所以回放能逐帧还原同一局 (带界面或无界面均可)。
+class Replay
+{
+public:
+    static const int SUBPIXEL = 4;      // 坐标量化精度 (1/4 像素)
+    static const int MAX_COORD = 1 << 16; // 输入坐标范围 [-MAX_COORD, MAX_COORD] 逻辑像素，超出的录像视为损坏
+
+    Replay();
+
+    // 把输入坐标量化到录像精度并限制在坐标范围内 (录制时先量化再交给逻辑核心)
+    static GameInput quantize(const GameInput &input);
+
+    // 默认录像路径 (每局结束覆盖写入)
+    static QString defaultPath();
+
+    // --- 录制 ---
+    void begin(quint64 seed, const LevelConfig &config, const LoadoutSnapshot &loadout,
+               const StressConfig &stress, const QSize &heroSize, double gameWidth);
+    void recordTick(const GameInput &input, double gameWidth);
+
+    // --- 回放 ---
+    // 按文件头初始化逻辑核心
+    void startSimulation(GameSimulation &sim) const;
+    // 取第 tick 帧输入，并把该帧的画面宽度同步给逻辑核心
+    GameInput applyTick(int tick, GameSimulation &sim) const;
+
+    int tickCount() const { return m_frames.size(); }
+    bool isEmpty() const { return m_frames.isEmpty(); }
+    quint64 seed() const { return m_seed; }
+    const LevelConfig &levelConfig() const { return m_config; }
+    const LoadoutSnapshot &loadout() const { return m_loadout; }
+    const StressConfig &stressConfig() const { return m_stress; }
+    QSize heroSize() const { return m_heroSize; }
+
+    // --- 序列化 ---
+    QByteArray encode() const;
+    bool decode(const QByteArray &data); // 格式错误时返回 false
+    bool save(const QString &path) const;
+    bool load(const QString &path);
+
+private:
+    quint64 m_seed;
+    LevelConfig m_config;
+    LoadoutSnapshot m_loadout;
+    StressConfig m_stress;
+    QSize m_heroSize;
+    double m_initialWidth;
+    QVector<ReplayFrame> m_frames;
+};
+
+#endif // REPLAY_H
@@ -0,0 +1,46 @@
+#include "ScaledPixmapCache.h"
+#include "TraceRecorder.h"
+#include "AssetManager.h"
+#include <QtMath>
+
+QHash<QString, ScaledPixmapCache::Entry> ScaledPixmapCache::m_entries;
+
+QImage ScaledPixmapCache::image(const QString &path)
+{
+    return AssetManager::image(path); // 原图由 AssetManager 统一解码并共享
+}
+
+QPixmap ScaledPixmapCache::scaled(const QString &key, const QImage &source, const QSize &size, qreal devicePixelRatio,
+                                  Qt::AspectRatioMode mode)
+{
+    if (source.isNull() || size.isEmpty())
+        return QPixmap();
+
+    Entry &entry = m_entries[key];
+    if (entry.sourceKey == source.cacheKey() && entry.size == size &&
+        qFuzzyCompare(entry.devicePixelRatio, devicePixelRatio) && entry.mode == mode)
+        return entry.pixmap;
+
+    const QByteArray detail = key.toUtf8();
+    TraceScope trace("asset", "scale pixmap", detail.constData());
+
+    // 先按逻辑尺寸算出保持比例后的大小，再乘设备像素比得到实际像素
+    const QSize logical = source.size().scaled(size, mode);
+    const QSize device(qMax(1, qCeil(logical.width() * devicePixelRatio)),
+                       qMax(1, qCeil(logical.height() * devicePixelRatio)));
+    QImage scaledImage = source.scaled(device, Qt::IgnoreAspectRatio, Qt::SmoothTransformation)
+                             .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    entry.sourceKey = source.cacheKey();
+    entry.size = size;
+    entry.devicePixelRatio = devicePixelRatio;
+    entry.mode = mode;
+    entry.pixmap = QPixmap::fromImage(scaledImage);
+    entry.pixmap.setDevicePixelRatio(devicePixelRatio);
+    return entry.pixmap;
+}
+
+void ScaledPixmapCache::clear()
+{
+    m_entries.clear();
+}
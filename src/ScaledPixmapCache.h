@@ -0,0 +1,41 @@
+#ifndef SCALEDPIXMAPCACHE_H
+#define SCALEDPIXMAPCACHE_H
+
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+
+// 缩放贴图缓存 (全局共享)
+// 背景 / HUD 图标每帧 drawImage(rect(), img) 或 img.scaled(...) 都要重新缩放一遍整张原图。
+// 这里按 key 只保留"最近一次请求尺寸"的一张 QPixmap：尺寸 / 设备像素比 / 原图不变时直接复用，
+// 只有窗口缩放、换屏或换图时才重新缩放一次。
+// 生成的 QPixmap 按 devicePixelRatio 存储设备像素，drawPixmap(x, y, pm) 即得到逻辑尺寸，高分屏上 1:1 清晰。
+class ScaledPixmapCache
+{
+public:
+    // 按路径取原图，同一路径只解码一次，各页面共享同一份 (见 AssetManager)
+    static QImage image(const QString &path);
+
+    // 取 source 缩放到 size (逻辑像素，按 mode 保持比例) 的贴图
+    // key 标识一个用途 (如 "bg" / "bossIcon")，同一 key 的旧尺寸结果会被替换
+    static QPixmap scaled(const QString &key, const QImage &source, const QSize &size, qreal devicePixelRatio,
+                          Qt::AspectRatioMode mode = Qt::IgnoreAspectRatio);
+
+    static void clear();
+
+private:
+    struct Entry
+    {
+        qint64 sourceKey = 0; // QImage::cacheKey()，原图换了即失效
+        QSize size;
+        qreal devicePixelRatio = 0;
+        Qt::AspectRatioMode mode = Qt::IgnoreAspectRatio;
+        QPixmap pixmap;
+    };
+
+    static QHash<QString, Entry> m_entries;
+};
+
+#endif // SCALEDPIXMAPCACHE_H
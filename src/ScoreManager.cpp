@@ -1,4 +1,5 @@
 #include "ScoreManager.h"
+#include "TraceRecorder.h"
 #include <QFile>
 #include <QTextStream>
 #include <QCoreApplication>
@@ -41,6 +42,7 @@ void ScoreManager::saveScore(int newScore)
     while (scores.size() > 10)
         scores.removeLast();
 
+    TraceScope trace("save", "ScoreManager::saveScore");
     QFile file(getFilePath());
     if (file.open(QIODevice::WriteOnly | QIODevice::Text))
     {
@@ -1,4 +1,5 @@
 #include "ShopWidget.h"
+#include "ScaledPixmapCache.h"
 #include "DataManager.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -9,7 +10,7 @@
 
 ShopWidget::ShopWidget(QWidget *parent) : QWidget(parent)
 {
-    bgImg.load("assets/game_bg.png");
+    bgImg = ScaledPixmapCache::image("assets/game_bg.png");
 
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
     mainLayout->setContentsMargins(50, 20, 50, 20);
@@ -109,7 +110,7 @@ void ShopWidget::paintEvent(QPaintEvent *)
 {
     QPainter p(this);
     if (!bgImg.isNull())
-        p.drawImage(rect(), bgImg);
+        p.drawPixmap(0, 0, ScaledPixmapCache::scaled("bg", bgImg, size(), devicePixelRatioF()));
     else
         p.fillRect(rect(), Qt::black);
 }
\ No newline at end of file
@@ -0,0 +1,405 @@
+#include "SimdKernels.h"
+#include "BulletStore.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// 只有确定可用 SSE2 时才编译 x86 路径 (x64 恒定可用；32 位需 /arch:SSE2 或 -msse2)
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define SIMD_X86 0
+#endif
+
+// GCC / Clang 需按函数开启 AVX2 指令；MSVC 无需开关即可使用全部内建函数
+#if SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SIMD_TARGET_AVX2
+#endif
+
+namespace
+{
+    std::atomic<int> g_isa(-1);
+
+    SimdKernels::Isa detectIsa()
+    {
+#if SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+        int regs[4];
+        __cpuid(regs, 0);
+        if (regs[0] >= 7)
+        {
+            __cpuid(regs, 1);
+            const bool osxsave = (regs[2] & (1 << 27)) != 0;
+            const bool avx = (regs[2] & (1 << 28)) != 0;
+            // 还要确认操作系统会保存 YMM 寄存器
+            if (osxsave && avx && (_xgetbv(0) & 6) == 6)
+            {
+                __cpuidex(regs, 7, 0);
+                if (regs[1] & (1 << 5))
+                    return SimdKernels::ISA_AVX2;
+            }
+        }
+        return SimdKernels::ISA_SSE2;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? SimdKernels::ISA_AVX2 : SimdKernels::ISA_SSE2;
+#endif
+#else
+        return SimdKernels::ISA_SCALAR;
+#endif
+    }
+
+    // 命中参数 (各实现共用)
+    struct HitParams
+    {
+        int required;
+        float size, half;
+        float left, top, right, bottom;
+        float cx, cy, r2;
+        bool useCircle;
+    };
+
+    inline bool hitScalar(float x, float y, quint8 flag, const HitParams &p)
+    {
+        if ((flag & p.required) != p.required)
+            return false;
+        if (x + p.size > p.left && x < p.right && y + p.size > p.top && y < p.bottom)
+            return true;
+        if (!p.useCircle)
+            return false;
+        const float dx = (x + p.half) - p.cx;
+        const float dy = (y + p.half) - p.cy;
+        return dx * dx + dy * dy < p.r2;
+    }
+
+    int hitTestScalar(const float *x, const float *y, const quint8 *flags, int begin, int n,
+                      const HitParams &p, int *out, int count)
+    {
+        for (int i = begin; i < n; ++i)
+        {
+            if (hitScalar(x[i], y[i], flags[i], p))
+                out[count++] = i;
+        }
+        return count;
+    }
+
+    // 把一组命中位展开成下标
+    inline int emitMask(unsigned mask, int base, int *out, int count)
+    {
+        while (mask)
+        {
+            int bit = 0;
+            while (!(mask & (1u << bit)))
+                ++bit;
+            out[count++] = base + bit;
+            mask &= mask - 1;
+        }
+        return count;
+    }
+
+    // 积分参数 (各实现共用)
+    struct MoveParams
+    {
+        int frozen;
+        float minX, minY, maxX, maxY;
+    };
+
+    void integrateScalar(float *x, float *y, const float *vx, const float *vy,
+                         float *prevX, float *prevY, quint8 *flags, int begin, int n,
+                         const MoveParams &p)
+    {
+        for (int i = begin; i < n; ++i)
+        {
+            prevX[i] = x[i];
+            prevY[i] = y[i];
+            if (flags[i] & p.frozen)
+                continue;
+            x[i] += vx[i];
+            y[i] += vy[i];
+            if (x[i] < p.minX || x[i] > p.maxX || y[i] < p.minY || y[i] > p.maxY)
+                flags[i] &= ~BulletStore::FLAG_ACTIVE;
+        }
+    }
+
+#if SIMD_X86
+    int hitTestSse2(const float *x, const float *y, const quint8 *flags, int n,
+                    const HitParams &p, int *out)
+    {
+        const __m128 size = _mm_set1_ps(p.size);
+        const __m128 half = _mm_set1_ps(p.half);
+        const __m128 left = _mm_set1_ps(p.left);
+        const __m128 top = _mm_set1_ps(p.top);
+        const __m128 right = _mm_set1_ps(p.right);
+        const __m128 bottom = _mm_set1_ps(p.bottom);
+        const __m128 cx = _mm_set1_ps(p.cx);
+        const __m128 cy = _mm_set1_ps(p.cy);
+        const __m128 r2 = _mm_set1_ps(p.useCircle ? p.r2 : 0.0f);
+        const __m128i required = _mm_set1_epi32(p.required);
+        const __m128i zero = _mm_setzero_si128();
+
+        int count = 0;
+        int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m128 vx = _mm_loadu_ps(x + i);
+            const __m128 vy = _mm_loadu_ps(y + i);
+
+            // 4 个标志字节 -> 4 个 32 位通道
+            int packed;
+            std::memcpy(&packed, flags + i, sizeof(packed));
+            __m128i f = _mm_cvtsi32_si128(packed);
+            f = _mm_unpacklo_epi16(_mm_unpacklo_epi8(f, zero), zero);
+            const __m128 flagOk = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(f, required), required));
+
+            __m128 box = _mm_cmpgt_ps(_mm_add_ps(vx, size), left);
+            box = _mm_and_ps(box, _mm_cmplt_ps(vx, right));
+            box = _mm_and_ps(box, _mm_cmpgt_ps(_mm_add_ps(vy, size), top));
+            box = _mm_and_ps(box, _mm_cmplt_ps(vy, bottom));
+
+            const __m128 dx = _mm_sub_ps(_mm_add_ps(vx, half), cx);
+            const __m128 dy = _mm_sub_ps(_mm_add_ps(vy, half), cy);
+            const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            const __m128 circle = _mm_cmplt_ps(d2, r2); // r2 为 0 时恒为假
+
+            const unsigned mask = (unsigned)_mm_movemask_ps(_mm_and_ps(flagOk, _mm_or_ps(box, circle)));
+            if (mask)
+                count = emitMask(mask, i, out, count);
+        }
+        return hitTestScalar(x, y, flags, i, n, p, out, count);
+    }
+
+    SIMD_TARGET_AVX2
+    int hitTestAvx2(const float *x, const float *y, const quint8 *flags, int n,
+                    const HitParams &p, int *out)
+    {
+        const __m256 size = _mm256_set1_ps(p.size);
+        const __m256 half = _mm256_set1_ps(p.half);
+        const __m256 left = _mm256_set1_ps(p.left);
+        const __m256 top = _mm256_set1_ps(p.top);
+        const __m256 right = _mm256_set1_ps(p.right);
+        const __m256 bottom = _mm256_set1_ps(p.bottom);
+        const __m256 cx = _mm256_set1_ps(p.cx);
+        const __m256 cy = _mm256_set1_ps(p.cy);
+        const __m256 r2 = _mm256_set1_ps(p.useCircle ? p.r2 : 0.0f);
+        const __m256i required = _mm256_set1_epi32(p.required);
+
+        int count = 0;
+        int i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m256 vx = _mm256_loadu_ps(x + i);
+            const __m256 vy = _mm256_loadu_ps(y + i);
+
+            const __m256i f = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(flags + i)));
+            const __m256 flagOk = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(f, required), required));
+
+            __m256 box = _mm256_cmp_ps(_mm256_add_ps(vx, size), left, _CMP_GT_OQ);
+            box = _mm256_and_ps(box, _mm256_cmp_ps(vx, right, _CMP_LT_OQ));
+            box = _mm256_and_ps(box, _mm256_cmp_ps(_mm256_add_ps(vy, size), top, _CMP_GT_OQ));
+            box = _mm256_and_ps(box, _mm256_cmp_ps(vy, bottom, _CMP_LT_OQ));
+
+            const __m256 dx = _mm256_sub_ps(_mm256_add_ps(vx, half), cx);
+            const __m256 dy = _mm256_sub_ps(_mm256_add_ps(vy, half), cy);
+            const __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            const __m256 circle = _mm256_cmp_ps(d2, r2, _CMP_LT_OQ);
+
+            const unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_and_ps(flagOk, _mm256_or_ps(box, circle)));
+            if (mask)
+                count = emitMask(mask, i, out, count);
+        }
+        return hitTestScalar(x, y, flags, i, n, p, out, count);
+    }
+
+    void integrateSse2(float *x, float *y, const float *vx, const float *vy,
+                       float *prevX, float *prevY, quint8 *flags, int n,
+                       const MoveParams &p)
+    {
+        const __m128 minX = _mm_set1_ps(p.minX);
+        const __m128 minY = _mm_set1_ps(p.minY);
+        const __m128 maxX = _mm_set1_ps(p.maxX);
+        const __m128 maxY = _mm_set1_ps(p.maxY);
+        const __m128i frozen = _mm_set1_epi32(p.frozen);
+        const __m128i zero = _mm_setzero_si128();
+        const int activeBytes = 0x01010101 * BulletStore::FLAG_ACTIVE;
+
+        int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            int packed;
+            std::memcpy(&packed, flags + i, sizeof(packed));
+            __m128i f = _mm_cvtsi32_si128(packed);
+            f = _mm_unpacklo_epi16(_mm_unpacklo_epi8(f, zero), zero);
+            // 冻结改为掩码：被冻结的通道速度清零，出界结果也被屏蔽
+            const __m128 move = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(f, frozen), zero));
+
+            const __m128 px = _mm_loadu_ps(x + i);
+            const __m128 py = _mm_loadu_ps(y + i);
+            _mm_storeu_ps(prevX + i, px);
+            _mm_storeu_ps(prevY + i, py);
+            const __m128 nx = _mm_add_ps(px, _mm_and_ps(move, _mm_loadu_ps(vx + i)));
+            const __m128 ny = _mm_add_ps(py, _mm_and_ps(move, _mm_loadu_ps(vy + i)));
+            _mm_storeu_ps(x + i, nx);
+            _mm_storeu_ps(y + i, ny);
+
+            __m128 out = _mm_or_ps(_mm_cmplt_ps(nx, minX), _mm_cmpgt_ps(nx, maxX));
+            out = _mm_or_ps(out, _mm_or_ps(_mm_cmplt_ps(ny, minY), _mm_cmpgt_ps(ny, maxY)));
+            out = _mm_and_ps(out, move);
+
+            // 32 位掩码压回 4 个字节，一次清掉出界子弹的存活位
+            __m128i kill = _mm_packs_epi32(_mm_castps_si128(out), zero);
+            kill = _mm_packs_epi16(kill, zero);
+            packed &= ~(_mm_cvtsi128_si32(kill) & activeBytes);
+            std::memcpy(flags + i, &packed, sizeof(packed));
+        }
+        integrateScalar(x, y, vx, vy, prevX, prevY, flags, i, n, p);
+    }
+
+    SIMD_TARGET_AVX2
+    void integrateAvx2(float *x, float *y, const float *vx, const float *vy,
+                       float *prevX, float *prevY, quint8 *flags, int n,
+                       const MoveParams &p)
+    {
+        const __m256 minX = _mm256_set1_ps(p.minX);
+        const __m256 minY = _mm256_set1_ps(p.minY);
+        const __m256 maxX = _mm256_set1_ps(p.maxX);
+        const __m256 maxY = _mm256_set1_ps(p.maxY);
+        const __m256i frozen = _mm256_set1_epi32(p.frozen);
+        const __m256i zero = _mm256_setzero_si256();
+        const quint64 activeBytes = 0x0101010101010101ULL * BulletStore::FLAG_ACTIVE;
+
+        int i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            quint64 packed;
+            std::memcpy(&packed, flags + i, sizeof(packed));
+            const __m256i f = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(flags + i)));
+            const __m256 move = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(f, frozen), zero));
+
+            const __m256 px = _mm256_loadu_ps(x + i);
+            const __m256 py = _mm256_loadu_ps(y + i);
+            _mm256_storeu_ps(prevX + i, px);
+            _mm256_storeu_ps(prevY + i, py);
+            const __m256 nx = _mm256_add_ps(px, _mm256_and_ps(move, _mm256_loadu_ps(vx + i)));
+            const __m256 ny = _mm256_add_ps(py, _mm256_and_ps(move, _mm256_loadu_ps(vy + i)));
+            _mm256_storeu_ps(x + i, nx);
+            _mm256_storeu_ps(y + i, ny);
+
+            __m256 out = _mm256_or_ps(_mm256_cmp_ps(nx, minX, _CMP_LT_OQ), _mm256_cmp_ps(nx, maxX, _CMP_GT_OQ));
+            out = _mm256_or_ps(out, _mm256_or_ps(_mm256_cmp_ps(ny, minY, _CMP_LT_OQ), _mm256_cmp_ps(ny, maxY, _CMP_GT_OQ)));
+            out = _mm256_and_ps(out, move);
+
+            const __m256i outBits = _mm256_castps_si256(out);
+            __m128i kill = _mm_packs_epi32(_mm256_castsi256_si128(outBits), _mm256_extracti128_si256(outBits, 1));
+            kill = _mm_packs_epi16(kill, _mm_setzero_si128());
+            quint64 killBytes;
+            _mm_storel_epi64((__m128i *)&killBytes, kill);
+            packed &= ~(killBytes & activeBytes);
+            std::memcpy(flags + i, &packed, sizeof(packed));
+        }
+        integrateScalar(x, y, vx, vy, prevX, prevY, flags, i, n, p);
+    }
+#endif
+}
+
+SimdKernels::Isa SimdKernels::activeIsa()
+{
+    int isa = g_isa.load(std::memory_order_relaxed);
+    if (isa < 0)
+    {
+        isa = detectIsa();
+        g_isa.store(isa, std::memory_order_relaxed);
+    }
+    return (Isa)isa;
+}
+
+const char *SimdKernels::isaName(Isa isa)
+{
+    switch (isa)
+    {
+    case ISA_SSE2:
+        return "sse2";
+    case ISA_AVX2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+void SimdKernels::setIsa(Isa isa)
+{
+    const Isa best = detectIsa();
+    g_isa.store(isa > best ? best : isa, std::memory_order_relaxed);
+}
+
+int SimdKernels::hitTest(const float *x, const float *y, const quint8 *flags, int n,
+                         quint8 requiredFlags, float size, const Aabb &box,
+                         float cx, float cy, float circleR2,
+                         int *outHits)
+{
+    HitParams p;
+    p.required = requiredFlags;
+    p.size = size;
+    p.half = size * 0.5f;
+    p.left = box.left;
+    p.top = box.top;
+    if (size <= 0)
+    {
+        // 点包含：x > left 的前一个浮点数 <=> x >= left，与 Aabb::contains 的左闭区间完全一致
+        p.size = 0;
+        p.half = 0;
+        p.left = std::nextafter(box.left, -std::numeric_limits<float>::infinity());
+        p.top = std::nextafter(box.top, -std::numeric_limits<float>::infinity());
+    }
+    p.right = box.right;
+    p.bottom = box.bottom;
+    p.cx = cx;
+    p.cy = cy;
+    p.r2 = circleR2;
+    p.useCircle = circleR2 > 0;
+
+    switch (activeIsa())
+    {
+#if SIMD_X86
+    case ISA_AVX2:
+        return hitTestAvx2(x, y, flags, n, p, outHits);
+    case ISA_SSE2:
+        return hitTestSse2(x, y, flags, n, p, outHits);
+#endif
+    default:
+        return hitTestScalar(x, y, flags, 0, n, p, outHits, 0);
+    }
+}
+
+void SimdKernels::integrate(float *x, float *y, const float *vx, const float *vy,
+                            float *prevX, float *prevY, quint8 *flags, int n,
+                            quint8 frozenFlags,
+                            float minX, float minY, float maxX, float maxY)
+{
+    MoveParams p;
+    p.frozen = frozenFlags;
+    p.minX = minX;
+    p.minY = minY;
+    p.maxX = maxX;
+    p.maxY = maxY;
+
+    switch (activeIsa())
+    {
+#if SIMD_X86
+    case ISA_AVX2:
+        integrateAvx2(x, y, vx, vy, prevX, prevY, flags, n, p);
+        return;
+    case ISA_SSE2:
+        integrateSse2(x, y, vx, vy, prevX, prevY, flags, n, p);
+        return;
+#endif
+    default:
+        integrateScalar(x, y, vx, vy, prevX, prevY, flags, 0, n, p);
+    }
+}
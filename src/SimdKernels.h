@@ -0,0 +1,47 @@
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+#include "Hitbox.h"
+#include <QtGlobal>
+
+// 子弹批处理内核 (SoA 数组上的向量化运算)
+// x86 以 SSE2 (一次 4 颗) 为基线，运行时检测到 AVX2 时切换到一次 8 颗的版本；
+// 其他平台退回标量实现。各版本结果完全一致。
+class SimdKernels
+{
+public:
+    enum Isa
+    {
+        ISA_SCALAR = 0,
+        ISA_SSE2,
+        ISA_AVX2
+    };
+
+    // 当前使用的指令集 (首次调用时检测)
+    static Isa activeIsa();
+    static const char *isaName(Isa isa);
+
+    // 强制指定指令集 (基准测试对比用)，超出 CPU 能力时自动降级
+    static void setIsa(Isa isa);
+
+    // 敌方子弹命中测试：
+    // 对 [0, n) 中同时带有 requiredFlags 全部位的子弹，判断其 size x size 判定框是否与 box 相交，
+    // 或 (circleR2 > 0 时) 子弹中心是否落在以 (cx, cy) 为圆心、半径平方为 circleR2 的圆内。
+    // size 为 0 时退化为点包含判定：子弹坐标落在 [left, right) x [top, bottom) 内 (同 Aabb::contains)。
+    // 命中下标按升序写入 outHits (容量需 >= n)，返回命中数量。
+    static int hitTest(const float *x, const float *y, const quint8 *flags, int n,
+                       quint8 requiredFlags, float size, const Aabb &box,
+                       float cx, float cy, float circleR2,
+                       int *outHits);
+
+    // 子弹积分 + 出界剔除：
+    // 先把当前位置存入 prevX / prevY，再对 (flags & frozenFlags) == 0 的子弹执行 x += vx, y += vy，
+    // 移动后落在闭区间 [minX, maxX] x [minY, maxY] 之外的清除 FLAG_ACTIVE。
+    // 被冻结的子弹原地不动、也不做剔除 (frozenFlags 传 0 表示不冻结)。
+    static void integrate(float *x, float *y, const float *vx, const float *vy,
+                          float *prevX, float *prevY, quint8 *flags, int n,
+                          quint8 frozenFlags,
+                          float minX, float minY, float maxX, float maxY);
+};
+
+#endif // SIMDKERNELS_H
@@ -0,0 +1,66 @@
+#include "SpatialGrid.h"
+
+SpatialGrid::SpatialGrid()
+    : m_cols(1), m_rows(1), m_invCellSize(1.0f)
+{
+    m_cellStart.fill(0, 2);
+}
+
+void SpatialGrid::reset(float width, float height, float cellSize)
+{
+    m_invCellSize = 1.0f / cellSize;
+    m_cols = (int)(width * m_invCellSize) + 1;
+    m_rows = (int)(height * m_invCellSize) + 1;
+    if (m_cols < 1)
+        m_cols = 1;
+    if (m_rows < 1)
+        m_rows = 1;
+
+    m_entryCells.clear();
+    m_entryIds.clear();
+    m_cellStart.fill(0, m_cols * m_rows + 1);
+}
+
+void SpatialGrid::insertPoint(int id, float x, float y)
+{
+    m_entryCells.append(cellY(y) * m_cols + cellX(x));
+    m_entryIds.append(id);
+}
+
+void SpatialGrid::insertRect(int id, float left, float top, float right, float bottom)
+{
+    int x0 = cellX(left), x1 = cellX(right);
+    int y0 = cellY(top), y1 = cellY(bottom);
+    for (int cy = y0; cy <= y1; ++cy)
+    {
+        for (int cx = x0; cx <= x1; ++cx)
+        {
+            m_entryCells.append(cy * m_cols + cx);
+            m_entryIds.append(id);
+        }
+    }
+}
+
+void SpatialGrid::build()
+{
+    // 计数排序：统计每格数量 -> 前缀和 -> 按登记顺序散布 (稳定)
+    const int n = m_entryIds.size();
+    const int cells = m_cols * m_rows;
+    for (int k = 0; k < n; ++k)
+        m_cellStart[m_entryCells[k] + 1]++;
+    for (int c = 0; c < cells; ++c)
+        m_cellStart[c + 1] += m_cellStart[c];
+
+    m_sortedIds.resize(n);
+    // m_cellStart[c] 兼作格子 c 的写入游标
+    for (int k = 0; k < n; ++k)
+    {
+        int cell = m_entryCells[k];
+        int slot = m_cellStart[cell]++;
+        m_sortedIds[slot] = m_entryIds[k];
+    }
+    // 散布时游标已推进到下一格的起点，整体右移一位复原
+    for (int c = cells; c > 0; --c)
+        m_cellStart[c] = m_cellStart[c - 1];
+    m_cellStart[0] = 0;
+}
@@ -0,0 +1,110 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <QVector>
+
+// 均匀网格 (碰撞粗筛)
+// 每个逻辑帧重建一次：先 insertPoint / insertRect 登记，再 build() 按格子做计数排序。
+// 同一格子内的元素保持插入顺序；超出网格的坐标会被夹到边缘格子，因此查询结果总是保守的。
+// 内部数组重复使用，容量稳定后重建不产生堆分配。
+class SpatialGrid
+{
+public:
+    SpatialGrid();
+
+    // 设定网格覆盖范围并清空内容 (原点为 (0, 0))
+    void reset(float width, float height, float cellSize);
+
+    // 点登记到其所在的一个格子
+    void insertPoint(int id, float x, float y);
+    // 矩形登记到其覆盖的所有格子
+    void insertRect(int id, float left, float top, float right, float bottom);
+
+    // 登记完成后调用，生成按格子排列的索引
+    void build();
+
+    // 遍历点 (x, y) 所在格子中的元素
+    template <typename Func>
+    void forEachInCell(float x, float y, Func func) const
+    {
+        int cell = cellY(y) * m_cols + cellX(x);
+        for (int k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k)
+            func(m_sortedIds[k]);
+    }
+
+    // 遍历矩形覆盖的所有格子中的元素 (矩形登记的元素可能被访问多次，调用方自行去重)
+    template <typename Func>
+    void forEachInRect(float left, float top, float right, float bottom, Func func) const
+    {
+        int x0 = cellX(left), x1 = cellX(right);
+        int y0 = cellY(top), y1 = cellY(bottom);
+        for (int cy = y0; cy <= y1; ++cy)
+        {
+            for (int cx = x0; cx <= x1; ++cx)
+            {
+                int cell = cy * m_cols + cx;
+                for (int k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k)
+                    func(m_sortedIds[k]);
+            }
+        }
+    }
+
+    // 遍历以格子 (cx, cy) 为中心、切比雪夫距离恰为 ring 的一圈格子中的元素 (ring 为 0 时即该格子本身)
+    // 由内向外逐圈调用可实现最近邻搜索：第 ring + 1 圈及更外的元素与查询点的距离至少为 ring * cellSize()
+    template <typename Func>
+    void forEachInRing(int cx, int cy, int ring, Func func) const
+    {
+        for (int y = cy - ring; y <= cy + ring; ++y)
+        {
+            if (y < 0 || y >= m_rows)
+                continue;
+            // 顶行 / 底行整行遍历，中间各行只取左右两端
+            const bool edgeRow = (y == cy - ring || y == cy + ring);
+            const int step = (edgeRow || ring == 0) ? 1 : 2 * ring;
+            for (int x = cx - ring; x <= cx + ring; x += step)
+            {
+                if (x < 0 || x >= m_cols)
+                    continue;
+                int cell = y * m_cols + x;
+                for (int k = m_cellStart[cell]; k < m_cellStart[cell + 1]; ++k)
+                    func(m_sortedIds[k]);
+            }
+        }
+    }
+
+    int entryCount() const { return m_entryIds.size(); }
+    int cols() const { return m_cols; }
+    int rows() const { return m_rows; }
+    float cellSize() const { return 1.0f / m_invCellSize; }
+
+    // 坐标所在格子 (超出网格的坐标夹到边缘格子)
+    // 先比较再取整，避免超大坐标转 int 溢出
+    int cellX(float x) const
+    {
+        if (x <= 0)
+            return 0;
+        float c = x * m_invCellSize;
+        return c < m_cols ? (int)c : m_cols - 1;
+    }
+    int cellY(float y) const
+    {
+        if (y <= 0)
+            return 0;
+        float c = y * m_invCellSize;
+        return c < m_rows ? (int)c : m_rows - 1;
+    }
+
+private:
+    int m_cols, m_rows;
+    float m_invCellSize;
+
+    // 登记阶段：每条记录 (格子, 元素ID)
+    QVector<int> m_entryCells;
+    QVector<int> m_entryIds;
+
+    // build() 之后：格子 c 的元素为 m_sortedIds[m_cellStart[c] .. m_cellStart[c + 1])
+    QVector<int> m_cellStart;
+    QVector<int> m_sortedIds;
+};
+
+#endif // SPATIALGRID_H
@@ -0,0 +1,156 @@
+#include "SpriteAtlas.h"
+#include <QtMath>
+#include <algorithm>
+
+SpriteAtlas::SpriteAtlas()
+{
+}
+
+void SpriteAtlas::clear()
+{
+    m_regions.clear();
+    m_pending.clear();
+    m_pages.clear();
+}
+
+int SpriteAtlas::add(const QImage &image, const QSizeF &logicalSize, qreal deviceScale, const QPointF &offset)
+{
+    const QSize pixels(qMax(1, qCeil(logicalSize.width() * deviceScale)),
+                       qMax(1, qCeil(logicalSize.height() * deviceScale)));
+
+    QImage stored;
+    if (image.isNull())
+    {
+        stored = QImage(pixels, QImage::Format_ARGB32_Premultiplied);
+        stored.fill(Qt::transparent); // 缺图时占位为透明，绘制端不用判空
+    }
+    else
+    {
+        stored = (image.size() == pixels) ? image : image.scaled(pixels, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        stored = stored.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    }
+
+    Region region;
+    region.logicalSize = logicalSize;
+    region.offset = offset;
+    region.source = QRectF(QPointF(0, 0), QSizeF(stored.size()));
+    m_regions.append(region);
+    m_pending.append(stored);
+    return m_regions.size() - 1;
+}
+
+void SpriteAtlas::build()
+{
+    m_pages.clear();
+    if (m_pending.isEmpty())
+        return;
+
+    // 1. 货架打包：按高度从高到低排，逐行从左往右摆，行满换行，页满换页
+    QVector<int> order(m_pending.size());
+    for (int i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b)
+                     { return m_pending[a].height() > m_pending[b].height(); });
+
+    QVector<QSize> pageSizes;
+    int page = 0, x = 0, shelfY = 0, shelfH = 0;
+    pageSizes.append(QSize(0, 0));
+    for (int id : order)
+    {
+        const QSize size = m_pending[id].size();
+        const int w = size.width() + PADDING;
+        const int h = size.height() + PADDING;
+
+        if (x > 0 && x + w > PAGE_SIZE)
+        {
+            // 换行
+            shelfY += shelfH;
+            x = 0;
+            shelfH = 0;
+        }
+        if (shelfY > 0 && shelfY + h > PAGE_SIZE)
+        {
+            // 换页 (超过单页的大图独占一页)
+            page++;
+            pageSizes.append(QSize(0, 0));
+            x = 0;
+            shelfY = 0;
+            shelfH = 0;
+        }
+
+        m_regions[id].page = page;
+        m_regions[id].source = QRectF(x, shelfY, size.width(), size.height());
+        x += w;
+        shelfH = qMax(shelfH, h);
+        pageSizes[page] = pageSizes[page].expandedTo(QSize(x, shelfY + shelfH));
+    }
+
+    // 2. 把每张图拷进所属页
+    QList<QImage> pages;
+    for (const QSize &size : pageSizes)
+    {
+        QImage image(size, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        pages.append(image);
+    }
+    {
+        QList<QPainter *> painters;
+        for (QImage &image : pages)
+        {
+            QPainter *p = new QPainter(&image);
+            p->setCompositionMode(QPainter::CompositionMode_Source);
+            painters.append(p);
+        }
+        for (int id = 0; id < m_regions.size(); ++id)
+            painters[m_regions[id].page]->drawImage(m_regions[id].source.topLeft(), m_pending[id]);
+        qDeleteAll(painters);
+    }
+
+    for (const QImage &image : pages)
+        m_pages.append(QPixmap::fromImage(image));
+    m_pending.clear();
+}
+
+void SpriteAtlas::draw(QPainter &p, int id, qreal x, qreal y) const
+{
+    const Region &r = m_regions[id];
+    p.drawPixmap(QRectF(QPointF(x + r.offset.x(), y + r.offset.y()), r.logicalSize), m_pages[r.page], r.source);
+}
+
+// ================= 批量绘制 =================
+void SpriteBatch::add(const SpriteAtlas &atlas, int id, qreal x, qreal y, qreal opacity)
+{
+    const SpriteAtlas::Region &r = atlas.region(id);
+    if (r.page >= m_fragments.size())
+        m_fragments.resize(r.page + 1);
+
+    // 片段以中心点定位，源矩形按页内像素给出，再缩放到逻辑尺寸
+    QPainter::PixmapFragment f = QPainter::PixmapFragment::create(
+        QPointF(x + r.offset.x() + r.logicalSize.width() / 2, y + r.offset.y() + r.logicalSize.height() / 2),
+        r.source,
+        r.logicalSize.width() / r.source.width(),
+        r.logicalSize.height() / r.source.height(),
+        0, opacity);
+    m_fragments[r.page].append(f);
+}
+
+void SpriteBatch::flush(QPainter &p, const SpriteAtlas &atlas)
+{
+    for (int page = 0; page < m_fragments.size(); ++page)
+    {
+        QVector<QPainter::PixmapFragment> &fragments = m_fragments[page];
+        if (fragments.isEmpty())
+            continue;
+        if (page < atlas.pageCount())
+            p.drawPixmapFragments(fragments.constData(), fragments.size(), atlas.page(page));
+        fragments.clear(); // 保留容量
+    }
+}
+
+int SpriteBatch::size() const
+{
+    int n = 0;
+    for (const auto &fragments : m_fragments)
+        n += fragments.size();
+    return n;
+}
@@ -0,0 +1,68 @@
+#ifndef SPRITEATLAS_H
+#define SPRITEATLAS_H
+
+#include <QImage>
+#include <QList>
+#include <QPainter>
+#include <QPixmap>
+#include <QRectF>
+#include <QVector>
+
+// 精灵图集
+// 把若干张小图 (战机 / 敌人 / 子弹) 按货架算法打包进一张或几张预乘 Alpha 的大 QPixmap。
+// 每个精灵记录所在页、源矩形 (页内像素) 以及逻辑尺寸 / 偏移，同一页的精灵可以用
+// QPainter::drawPixmapFragments 一次提交 (见 SpriteBatch)。
+// 用法：clear() -> 多次 add() -> build()；之后 add() 返回的编号即可用于绘制，直到下次 clear()。
+class SpriteAtlas
+{
+public:
+    static const int PAGE_SIZE = 2048; // 单页最大边长 (像素)
+    static const int PADDING = 1;      // 精灵之间留 1 像素透明边，避免缩放采样串色
+
+    struct Region
+    {
+        int page = -1;
+        QRectF source;      // 页内像素矩形
+        QSizeF logicalSize; // 绘制尺寸 (逻辑像素)
+        QPointF offset;     // 左上角相对绘制坐标的偏移 (逻辑像素)
+    };
+
+    SpriteAtlas();
+
+    void clear();
+
+    // 加入一张图：按 logicalSize x deviceScale 的像素尺寸存储 (尺寸不符时平滑缩放)，返回精灵编号
+    int add(const QImage &image, const QSizeF &logicalSize, qreal deviceScale,
+            const QPointF &offset = QPointF());
+
+    // 打包并生成页面 (之前 add 的图在此之后释放)
+    void build();
+
+    int spriteCount() const { return m_regions.size(); }
+    int pageCount() const { return m_pages.size(); }
+    const Region &region(int id) const { return m_regions[id]; }
+    const QPixmap &page(int index) const { return m_pages[index]; }
+
+    // 单独绘制一个精灵 (逻辑坐标，左上角约定同 drawImage)
+    void draw(QPainter &p, int id, qreal x, qreal y) const;
+
+private:
+    QVector<Region> m_regions;
+    QList<QImage> m_pending; // build() 前暂存的图 (下标同 m_regions)
+    QList<QPixmap> m_pages;
+};
+
+// 按图集页分组的批量绘制：一帧内 add() 任意多个精灵，flush() 时每页只调用一次 drawPixmapFragments
+// 片段数组跨帧复用，稳定运行时不再分配内存
+class SpriteBatch
+{
+public:
+    void add(const SpriteAtlas &atlas, int id, qreal x, qreal y, qreal opacity = 1.0);
+    void flush(QPainter &p, const SpriteAtlas &atlas);
+    int size() const;
+
+private:
+    QVector<QVector<QPainter::PixmapFragment>> m_fragments; // 下标为页号
+};
+
+#endif // SPRITEATLAS_H
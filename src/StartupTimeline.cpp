@@ -0,0 +1,75 @@
+#include "StartupTimeline.h"
+#include "TraceRecorder.h"
+#include <QDebug>
+
+StartupTimeline::Mark StartupTimeline::m_marks[StartupTimeline::MAX_MARKS];
+int StartupTimeline::m_count = 0;
+qint64 StartupTimeline::m_startNs = 0;
+bool StartupTimeline::m_finished = false;
+
+void StartupTimeline::begin()
+{
+    m_count = 0;
+    m_finished = false;
+    m_startNs = TraceRecorder::nowNs();
+    mark("begin");
+}
+
+void StartupTimeline::mark(const char *name)
+{
+    if (m_finished || m_count >= MAX_MARKS)
+        return;
+    m_marks[m_count].name = name;
+    m_marks[m_count].ns = TraceRecorder::nowNs();
+    m_count++;
+    TraceRecorder::instant("startup", name);
+}
+
+void StartupTimeline::finish(const char *name)
+{
+    if (m_finished)
+        return;
+    mark(name);
+    m_finished = true;
+
+    qDebug().noquote() << summary();
+    if (totalMs() > BUDGET_MS)
+        qWarning().noquote() << QString("[startup] 首帧耗时 %1 ms，超出预算 %2 ms").arg(totalMs(), 0, 'f', 1).arg(BUDGET_MS);
+}
+
+void StartupTimeline::abort(const char *name)
+{
+    if (m_finished)
+        return;
+    mark(name);
+    m_finished = true;
+
+    qDebug().noquote() << summary();
+    qDebug().noquote() << QString("[startup] 启动在 \"%1\" 处改道，不计首帧预算").arg(QString::fromUtf8(name));
+}
+
+bool StartupTimeline::isFinished()
+{
+    return m_finished;
+}
+
+double StartupTimeline::totalMs()
+{
+    const qint64 endNs = (m_finished && m_count > 0) ? m_marks[m_count - 1].ns : TraceRecorder::nowNs();
+    return (endNs - m_startNs) / 1e6;
+}
+
+QString StartupTimeline::summary()
+{
+    QString text = "[startup] 冷启动时间线 (本段 / 累计 ms):";
+    for (int i = 0; i < m_count; ++i)
+    {
+        const double sinceStart = (m_marks[i].ns - m_startNs) / 1e6;
+        const double step = i > 0 ? (m_marks[i].ns - m_marks[i - 1].ns) / 1e6 : 0.0;
+        text += QString("\n  %1 %2 %3")
+                    .arg(QString::fromUtf8(m_marks[i].name), -24)
+                    .arg(step, 8, 'f', 1)
+                    .arg(sinceStart, 8, 'f', 1);
+    }
+    return text;
+}
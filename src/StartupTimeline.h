@@ -0,0 +1,42 @@
+#ifndef STARTUPTIMELINE_H
+#define STARTUPTIMELINE_H
+
+#include <QString>
+#include <QtGlobal>
+
+// 冷启动时间线
+// main() 开头 begin() 归零，启动路径上各关键点 mark()，第一帧菜单画出时 finish() 一次性输出整条时间线
+// (每段耗时 + 累计)，并与预算 BUDGET_MS 比较，超出时给出警告。
+// 开启事件追踪时各时间点同时记为 trace 瞬时事件。名字必须是静态字符串。只在 GUI 线程使用。
+class StartupTimeline
+{
+public:
+    static const int MAX_MARKS = 32;
+    static const int BUDGET_MS = 1500; // 启动到首帧菜单的预算
+
+    static void begin();
+    static void mark(const char *name);
+    // 记录最后一个时间点并输出时间线 (只生效一次)
+    static void finish(const char *name);
+    // 启动路径被改道 (如命令行直接回放，菜单不会显示)：同样结束并输出时间线，但不与预算比较
+    static void abort(const char *name);
+
+    static bool isFinished();
+    // 从 begin() 到 finish() 的毫秒数 (未结束时为当前已过时间)
+    static double totalMs();
+    static QString summary();
+
+private:
+    struct Mark
+    {
+        const char *name;
+        qint64 ns;
+    };
+
+    static Mark m_marks[MAX_MARKS];
+    static int m_count;
+    static qint64 m_startNs;
+    static bool m_finished;
+};
+
+#endif // STARTUPTIMELINE_H
@@ -0,0 +1,240 @@
+#include "TraceRecorder.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    // 一个事件槽位 (seqlock：写入中 seq 为奇数，写完为偶数)
+    struct TraceSlot
+    {
+        std::atomic<quint64> seq;
+        const char *category;
+        const char *name;
+        char phase; // 'X' 区间 / 'i' 瞬时
+        quint32 tid;
+        qint64 tsNs;
+        qint64 durNs;
+        char detail[TraceRecorder::DETAIL_LEN];
+    };
+
+    // 导出时的快照
+    struct TraceEvent
+    {
+        const char *category;
+        const char *name;
+        char phase;
+        quint32 tid;
+        qint64 tsNs;
+        qint64 durNs;
+        char detail[TraceRecorder::DETAIL_LEN];
+    };
+
+    std::atomic<bool> g_enabled(false);
+    std::atomic<TraceSlot *> g_slots(nullptr); // 首次开启时分配，之后不再释放
+    std::atomic<quint64> g_head(0);
+    std::atomic<quint32> g_nextTid(0);
+
+    quint32 currentTid()
+    {
+        thread_local quint32 tid = g_nextTid.fetch_add(1, std::memory_order_relaxed) + 1;
+        return tid;
+    }
+
+    void record(char phase, const char *category, const char *name, qint64 tsNs, qint64 durNs, const char *detail)
+    {
+        TraceSlot *slots = g_slots.load(std::memory_order_acquire);
+        if (!slots)
+            return;
+
+        const quint64 index = g_head.fetch_add(1, std::memory_order_relaxed);
+        TraceSlot &s = slots[index & (TraceRecorder::CAPACITY - 1)];
+
+        s.seq.store(index * 2 + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        s.category = category;
+        s.name = name;
+        s.phase = phase;
+        s.tid = currentTid();
+        s.tsNs = tsNs;
+        s.durNs = durNs;
+        if (detail)
+        {
+            std::strncpy(s.detail, detail, TraceRecorder::DETAIL_LEN - 1);
+            s.detail[TraceRecorder::DETAIL_LEN - 1] = '\0';
+        }
+        else
+        {
+            s.detail[0] = '\0';
+        }
+
+        s.seq.store(index * 2 + 2, std::memory_order_release);
+    }
+
+    void appendJsonString(QByteArray &out, const char *text)
+    {
+        out.append('"');
+        for (const char *c = text; *c; ++c)
+        {
+            const unsigned char ch = (unsigned char)*c;
+            if (ch == '"' || ch == '\\')
+            {
+                out.append('\\');
+                out.append((char)ch);
+            }
+            else if (ch < 0x20)
+            {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", ch);
+                out.append(buf);
+            }
+            else
+            {
+                out.append((char)ch);
+            }
+        }
+        out.append('"');
+    }
+}
+
+void TraceRecorder::setEnabled(bool enabled)
+{
+    if (enabled && !g_slots.load(std::memory_order_acquire))
+    {
+        TraceSlot *slots = new TraceSlot[CAPACITY];
+        for (int i = 0; i < CAPACITY; ++i)
+            slots[i].seq.store(0, std::memory_order_relaxed);
+        TraceSlot *expected = nullptr;
+        if (!g_slots.compare_exchange_strong(expected, slots, std::memory_order_acq_rel))
+            delete[] slots; // 其他线程已经分配过
+    }
+    nowNs(); // 确保时钟在第一条事件之前启动
+    g_enabled.store(enabled, std::memory_order_release);
+}
+
+bool TraceRecorder::isEnabled()
+{
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+qint64 TraceRecorder::nowNs()
+{
+    static const QElapsedTimer clock = []
+    {
+        QElapsedTimer t;
+        t.start();
+        return t;
+    }();
+    return clock.nsecsElapsed();
+}
+
+void TraceRecorder::complete(const char *category, const char *name, qint64 startNs, qint64 durationNs,
+                             const char *detail)
+{
+    if (isEnabled())
+        record('X', category, name, startNs, durationNs, detail);
+}
+
+void TraceRecorder::instant(const char *category, const char *name, const char *detail)
+{
+    if (isEnabled())
+        record('i', category, name, nowNs(), 0, detail);
+}
+
+void TraceRecorder::clear()
+{
+    TraceSlot *slots = g_slots.load(std::memory_order_acquire);
+    if (!slots)
+        return;
+    for (int i = 0; i < CAPACITY; ++i)
+        slots[i].seq.store(0, std::memory_order_relaxed);
+}
+
+bool TraceRecorder::writeJson(const QString &path)
+{
+    // 1. 拷出所有完整的槽位 (写入中或读取期间被覆盖的槽位直接丢弃)
+    std::vector<TraceEvent> events;
+    if (TraceSlot *slots = g_slots.load(std::memory_order_acquire))
+    {
+        events.reserve(CAPACITY);
+        for (int i = 0; i < CAPACITY; ++i)
+        {
+            const TraceSlot &s = slots[i];
+            const quint64 before = s.seq.load(std::memory_order_acquire);
+            if (before == 0 || (before & 1))
+                continue;
+
+            TraceEvent e;
+            e.category = s.category;
+            e.name = s.name;
+            e.phase = s.phase;
+            e.tid = s.tid;
+            e.tsNs = s.tsNs;
+            e.durNs = s.durNs;
+            std::memcpy(e.detail, s.detail, sizeof(e.detail));
+            e.detail[DETAIL_LEN - 1] = '\0';
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s.seq.load(std::memory_order_relaxed) != before)
+                continue;
+            events.push_back(e);
+        }
+    }
+    std::sort(events.begin(), events.end(), [](const TraceEvent &a, const TraceEvent &b)
+              { return a.tsNs < b.tsNs; });
+
+    // 2. 生成 JSON (时间单位：微秒)
+    QByteArray out;
+    out.reserve(64 + (int)events.size() * 120);
+    out.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    out.append("{\"ph\":\"M\",\"pid\":1,\"tid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"QtSpaceShooter\"}}");
+    char buf[96];
+    for (const TraceEvent &e : events)
+    {
+        out.append(",\n{\"ph\":\"");
+        out.append(e.phase);
+        out.append("\",\"cat\":");
+        appendJsonString(out, e.category);
+        out.append(",\"name\":");
+        appendJsonString(out, e.name);
+        std::snprintf(buf, sizeof(buf), ",\"pid\":1,\"tid\":%u,\"ts\":%.3f", e.tid, e.tsNs / 1000.0);
+        out.append(buf);
+        if (e.phase == 'X')
+        {
+            std::snprintf(buf, sizeof(buf), ",\"dur\":%.3f", e.durNs / 1000.0);
+            out.append(buf);
+        }
+        else
+        {
+            out.append(",\"s\":\"g\""); // 瞬时事件画成贯穿所有线程的竖线
+        }
+        if (e.detail[0])
+        {
+            out.append(",\"args\":{\"detail\":");
+            appendJsonString(out, e.detail);
+            out.append('}');
+        }
+        out.append('}');
+    }
+    out.append("\n]}\n");
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    const bool ok = file.write(out) == out.size();
+    file.close();
+    return ok;
+}
+
+QString TraceRecorder::defaultPath()
+{
+    return QCoreApplication::applicationDirPath() + "/trace_" +
+           QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss") + ".json";
+}
@@ -0,0 +1,66 @@
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <QString>
+#include <QtGlobal>
+
+// 事件追踪 (导出为 Chrome trace-event JSON，可在 chrome://tracing 或 Perfetto 打开)
+// 事件写入固定容量的环形缓冲区：写入端只做一次原子 fetch_add 拿槽位，无锁、无堆分配，
+// 任意线程可同时写；缓冲区写满后覆盖最旧的事件。writeJson() 在导出时跳过正被改写的槽位。
+// 事件名 / 分类必须是静态字符串 (只保存指针)，可变内容放进 detail (截断到 DETAIL_LEN - 1 字节)。
+class TraceRecorder
+{
+public:
+    static const int CAPACITY = 1 << 16; // 必须是 2 的幂
+    static const int DETAIL_LEN = 48;
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // 单调时钟 (纳秒，进程内首次调用时归零)
+    static qint64 nowNs();
+
+    // 区间事件 (trace 中的 "X" 事件：开始时间 + 时长)
+    static void complete(const char *category, const char *name, qint64 startNs, qint64 durationNs,
+                         const char *detail = nullptr);
+    // 瞬时事件 ("i" 事件)，如 BOSS 状态切换
+    static void instant(const char *category, const char *name, const char *detail = nullptr);
+
+    // 丢弃已记录的事件
+    static void clear();
+
+    // 导出当前缓冲区内容 (按时间排序)；失败返回 false
+    static bool writeJson(const QString &path);
+
+    // 默认导出路径：程序目录/trace_时间戳.json
+    static QString defaultPath();
+};
+
+// 作用域追踪：析构时记录一个区间事件；未开启追踪时只做一次原子读
+class TraceScope
+{
+public:
+    TraceScope(const char *category, const char *name, const char *detail = nullptr)
+        : m_category(category),
+          m_name(name),
+          m_detail(detail),
+          m_startNs(TraceRecorder::isEnabled() ? TraceRecorder::nowNs() : -1)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (m_startNs >= 0)
+            TraceRecorder::complete(m_category, m_name, m_startNs, TraceRecorder::nowNs() - m_startNs, m_detail);
+    }
+
+private:
+    Q_DISABLE_COPY(TraceScope)
+
+    const char *m_category;
+    const char *m_name;
+    const char *m_detail; // 只在析构时读取，调用方需保证其生命周期覆盖整个作用域
+    qint64 m_startNs;
+};
+
+#endif // TRACERECORDER_H
@@ -39,17 +39,21 @@ struct PlaneStats
     double viewHp;
 };
 
-// 子弹
-struct Bullet
+// 出击配置快照 (战机 + 装备叠加后的最终数值)
+// 由 DataManager 在配置变化时重新计算，游戏循环与 HUD 每帧只读这里的数字
+struct LoadoutSnapshot
 {
-    double x, y;
-    double speedX, speedY;
-    bool isEnemy;
-    bool active;
-    int hitCount = 0;
-    bool isSpecial = false; // 【新增】是否为特殊技能弹幕 (绘制不同外观)
+    int planeId = 0;
+    int coreId = -1, armorId = -1, engineId = -1;
+    int maxHp = 1;          // 最大生命
+    int shootInterval = 12; // 射击间隔 (逻辑帧)
+    int bulletDamage = 1;   // 每颗子弹伤害
+    double speed = 1.0;     // 移速倍率
+    double fireRate = 1.0;  // 射速倍率
 };
 
+// 子弹见 BulletStore.h (SoA 存储)
+
 // 敌人
 struct Enemy
 {
@@ -75,6 +79,8 @@ struct Enemy
     double attackTargetY; // 锁定目标Y
     double dashSpeedX;    // 【新增】冲刺速度X
     double dashSpeedY;    // 【新增】冲刺速度Y
+
+    double prevX = 0, prevY = 0; // 上一逻辑帧位置 (插值渲染用)
 };
 
 // --- 【新增】装备系统定义 ---
@@ -119,4 +125,26 @@ struct LevelConfig
     int bossHp;
 };
 
+// 压力测试参数 (弹幕上限摸底用，正常游戏保持默认值)
+struct StressConfig
+{
+    static const int MAX_EMISSION_MULTIPLIER = 64;
+    static const int MAX_SPAWN_INTERVAL = 100000;
+    static const int MAX_CAPACITY = 1 << 20; // 单个对象池的容量上限
+
+    int emissionMultiplier = 1; // BOSS 每次发射的弹数倍率 (螺旋臂 / 扇形 / 弹幕墙密度 / 随机弹)
+    int spawnInterval = 0;      // 小怪刷新间隔 (逻辑帧)，>0 时覆盖默认公式，且不受 20 帧下限约束
+    int bulletCapacity = 0;     // 子弹池容量，0 为默认
+    int enemyCapacity = 0;      // 敌人池容量，0 为默认
+
+    // 各项都在合理范围内 (录像解码时用来拒绝损坏的文件)
+    bool isValid() const
+    {
+        return emissionMultiplier >= 1 && emissionMultiplier <= MAX_EMISSION_MULTIPLIER &&
+               spawnInterval >= 0 && spawnInterval <= MAX_SPAWN_INTERVAL &&
+               bulletCapacity >= 0 && bulletCapacity <= MAX_CAPACITY &&
+               enemyCapacity >= 0 && enemyCapacity <= MAX_CAPACITY;
+    }
+};
+
 #endif // COMMON_H
\ No newline at end of file
@@ -1,10 +1,75 @@
 #include <QApplication>
 #include "MainWindow.h"
+#include "TraceRecorder.h"
+#include "AssetManager.h"
+#include "AssetPack.h"
+#include "StartupTimeline.h"
+#include <QDebug>
 
 int main(int argc, char *argv[])
 {
+    // 事件追踪要在时间线归零前打开，启动阶段的时间点才会进 trace (此时还没有 QApplication，直接看 argv)
+    for (int i = 1; i < argc; ++i)
+    {
+        if (qstrcmp(argv[i], "--trace") == 0)
+            TraceRecorder::setEnabled(true);
+    }
+
+    StartupTimeline::begin();
     QApplication app(argc, argv);
+    StartupTimeline::mark("QApplication");
+
+    // 用法: QtSpaceShooter [--stress 倍率] [--spawn 刷怪间隔] [--replay <录像文件>] [--trace [输出文件]]
+    const QStringList args = app.arguments();
+
+    // 事件追踪：从启动开始记录 (含各页面资源加载)，退出时导出 trace JSON
+    QString tracePath;
+    int traceArg = args.indexOf("--trace");
+    if (traceArg >= 0)
+    {
+        tracePath = (traceArg + 1 < args.size() && !args[traceArg + 1].startsWith("--"))
+                        ? args[traceArg + 1]
+                        : TraceRecorder::defaultPath();
+    }
+
+    // 构建时烘焙的资源包：映射后包内贴图免解码；没有资源包时退回读 assets/ 原文件
+    AssetPack::open(AssetPack::defaultPath());
+    StartupTimeline::mark("AssetPack::open");
+
+    // 其余贴图在线程池里并行解码，页面构造时直接取结果
+    AssetManager::preloadAll();
+    StartupTimeline::mark("AssetManager::preloadAll");
+
     MainWindow w;
     w.show();
-    return app.exec();
+    StartupTimeline::mark("MainWindow::show");
+
+    // 弹幕压力测试：BOSS 发射量乘以倍率，子弹池按倍率扩容
+    StressConfig stress;
+    int stressArg = args.indexOf("--stress");
+    if (stressArg >= 0 && stressArg + 1 < args.size())
+    {
+        stress.emissionMultiplier = qBound(1, args[stressArg + 1].toInt(), (int)StressConfig::MAX_EMISSION_MULTIPLIER);
+        stress.bulletCapacity = BulletStore::DEFAULT_CAPACITY * stress.emissionMultiplier;
+    }
+    int spawnArg = args.indexOf("--spawn");
+    if (spawnArg >= 0 && spawnArg + 1 < args.size())
+    {
+        stress.spawnInterval = qBound(1, args[spawnArg + 1].toInt(), (int)StressConfig::MAX_SPAWN_INTERVAL);
+        stress.enemyCapacity = EnemyPool::DEFAULT_CAPACITY * 20 / stress.spawnInterval; // 按默认最快刷怪速度 (20 帧) 等比扩容
+    }
+    w.setStressConfig(stress);
+
+    int replayArg = args.indexOf("--replay");
+    if (replayArg >= 0 && replayArg + 1 < args.size())
+        w.playReplay(args[replayArg + 1]);
+
+    const int ret = app.exec();
+
+    if (!tracePath.isEmpty() && TraceRecorder::isEnabled())
+    {
+        if (!TraceRecorder::writeJson(tracePath))
+            qWarning() << "无法写入事件追踪:" << tracePath;
+    }
+    return ret;
 }
\ No newline at end of file
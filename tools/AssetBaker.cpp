@@ -0,0 +1,88 @@
+// QtSpaceShooterAssetBaker: 构建时资源烘焙
+// 按 AssetManager 的资源清单把 assets/ 下的贴图解码、缩放到游戏内尺寸并转成预乘 ARGB32，
+// 把 WAV 音效解出 PCM，一起写进带索引头的 assets.pack (格式见 AssetPack.h)。
+// 游戏运行时内存映射该文件，启动不再解码大 PNG。
+// 用法:
+//   QtSpaceShooterAssetBaker <源码目录> <输出文件>
+
+#include "AssetManager.h"
+#include "AssetPack.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <QTextStream>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    if (args.size() != 3)
+    {
+        err << "usage: QtSpaceShooterAssetBaker <source dir> <output pack>\n";
+        return 2;
+    }
+
+    // 输出路径先转绝对路径，再切到源码目录 (清单里是相对 assets/ 的路径)
+    const QString outputPath = QFileInfo(args[2]).absoluteFilePath();
+    if (!QDir::setCurrent(args[1]))
+    {
+        err << "cannot enter source dir: " << args[1] << "\n";
+        return 1;
+    }
+
+    AssetPack::Writer writer;
+    QSet<QString> baked;
+
+    // 贴图：先全部排进线程池并行解码，再按清单顺序取结果
+    QList<AssetManager::ImageRequest> images;
+    for (const AssetManager::ImageRequest &item : AssetManager::imageManifest())
+    {
+        const QString key = AssetManager::key(item.path, item.box);
+        if (!item.bake || baked.contains(key) || !QFileInfo::exists(item.path))
+            continue;
+        baked.insert(key);
+        images.append(item);
+        AssetManager::request(item.path, item.box);
+    }
+    for (const AssetManager::ImageRequest &item : images)
+    {
+        const QImage image = AssetManager::image(item.path, item.box);
+        if (image.isNull())
+        {
+            err << "cannot decode image: " << item.path << "\n";
+            return 1;
+        }
+        writer.addImage(AssetManager::key(item.path, item.box), image);
+    }
+
+    // 音效：WAV -> PCM
+    for (const QString &path : AssetManager::soundManifest())
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly))
+        {
+            err << "missing sound: " << path << "\n";
+            return 1;
+        }
+        AssetPack::Sound format;
+        QByteArray pcm;
+        if (!AssetPack::decodeWav(file.readAll(), format, pcm))
+        {
+            err << "unsupported wav: " << path << "\n";
+            return 1;
+        }
+        writer.addSound(path, format, pcm);
+    }
+
+    if (!writer.write(outputPath))
+    {
+        err << "cannot write pack: " << outputPath << "\n";
+        return 1;
+    }
+    out << "baked " << writer.count() << " assets -> " << outputPath << "\n";
+    return 0;
+}